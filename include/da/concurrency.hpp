@@ -0,0 +1,20 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      concurrency.hpp
+ * @brief     structures for concurrency
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONCURRENCY_HPP_
+#define _DA_CONCURRENCY_HPP_
+
+#include <da/config.hpp>
+#include <da/concurrency/epoch.hpp>
+#include <da/concurrency/per_thread.hpp>
+#include <da/concurrency/sharded_counter.hpp>
+#include <da/concurrency/thread_index.hpp>
+
+#endif // _DA_CONCURRENCY_HPP_
@@ -0,0 +1,254 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      epoch.hpp
+ * @brief     Epoch-based reclamation for lock-free structures
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONCURRENCY_EPOCH_HPP_
+#define _DA_CONCURRENCY_EPOCH_HPP_
+
+#include <da/config.hpp>
+#include <da/concurrency/per_thread.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>  // for std::this_thread::yield()
+#include <utility> // for std::exchange()
+#include <vector>
+
+DA_BEGIN_DETAIL
+
+/// An object waiting to be freed
+struct epoch_retired {
+	void* ptr;
+	void (*deleter)(void*);
+};
+
+/// The objects retired by a thread in the same epoch
+struct epoch_bag {
+	std::vector<epoch_retired> objects;
+	uint64_t                   epoch = 0;
+
+	void free() noexcept {
+		for(const epoch_retired& r : objects) {
+			r.deleter(r.ptr);
+		}
+		objects.clear();
+	}
+};
+
+/**
+ * @brief The state of a thread in an epoch domain
+ * @note  Only state is read by other threads, the rest is owned by the thread using it.
+ *        It is kept for the next thread with the same thread_index() after the thread exits,
+ *        together with the garbage not freed yet
+ */
+struct epoch_record {
+	std::atomic<uint64_t> state{0}; // (epoch << 1) | 1 when pinned, 0 otherwise
+	uint32_t              pins      = 0;
+	size_t                pending   = 0; // The number of objects in bags
+	size_t                unscanned = 0; // Retired since the last try_advance()
+	epoch_bag             bags[3];       // Indexed by epoch % 3
+
+	epoch_record() noexcept = default;
+
+	epoch_record(const epoch_record&)            = delete;
+	epoch_record& operator=(const epoch_record&) = delete;
+
+	~epoch_record() {
+		for(epoch_bag& b : bags) {
+			b.free();
+		}
+	}
+};
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A domain of epoch-based reclamation, which defers freeing the objects removed from
+ *        lock-free structures until no thread can be reading them
+ * @note  Threads pin() the domain while accessing the shared structures, and retire() the objects
+ *        they unlink. The global epoch only advances when every pinned thread has seen it,
+ *        so an object retired in epoch e is freed once the epoch reaches e + 2
+ * @note  Retiring & pinning only touch thread-local data & the epoch, the threads are scanned once
+ *        every batch_size retirements, and a batch is freed without any lock
+ * @note  The garbage is bounded by about 3 * batch_size objects per thread, as long as no thread
+ *        stays pinned. A thread blocked while pinned stops all reclamation, so keep guards short
+ * @note  The garbage left by an exited thread is freed by the next thread with the same thread_index(),
+ *        or by the destructor of the domain, which must outlive all users
+ */
+class epoch_domain {
+	typedef _DA_DETAIL epoch_record record;
+	typedef _DA_DETAIL epoch_bag    bag;
+
+	public:
+	static inline constexpr size_t batch_size = 64;
+
+	/// Keeps the calling thread pinned while alive, guards may be nested
+	class [[nodiscard]] guard {
+		friend class epoch_domain;
+
+		epoch_domain* m_domain;
+		record*       m_record;
+
+		guard(epoch_domain* d, record* r) noexcept
+			: m_domain(d)
+			, m_record(r) { }
+
+		public:
+		guard(const guard&)            = delete;
+		guard& operator=(const guard&) = delete;
+
+		guard(guard&& g) noexcept
+			: m_domain(std::exchange(g.m_domain, nullptr))
+			, m_record(std::exchange(g.m_record, nullptr)) { }
+
+		~guard() {
+			if(m_record != nullptr) {
+				m_domain->_M_unpin(*m_record);
+			}
+		}
+	};
+
+	public: // Constructors
+	epoch_domain() noexcept = default;
+
+	epoch_domain(const epoch_domain&)            = delete;
+	epoch_domain& operator=(const epoch_domain&) = delete;
+
+	public: // Operations
+	/// Pin the calling thread, the objects read until the guard is destroyed are not freed
+	guard pin() {
+		record& r = m_records.local();
+		DA_IFLIKELY(r.pins++ == 0) {
+			uint64_t e = m_epoch.load(std::memory_order_relaxed);
+			while(true) {
+				r.state.store((e << 1) | 1, std::memory_order_relaxed);
+				// Make the pin visible before reading any shared object, and recheck the epoch,
+				// which may have advanced past e before the pin was seen by try_advance()
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				const uint64_t now = m_epoch.load(std::memory_order_relaxed);
+				DA_IFLIKELY(now == e) {
+					break;
+				}
+				e = now;
+			}
+		}
+		return guard(this, &r);
+	}
+
+	/**
+	 * @brief Free @param p by @param deleter once no pinned thread can be reading it
+	 * @note  @param p must have been unlinked, so that no thread pinned later can reach it.
+	 *        The calling thread does not need to be pinned
+	 */
+	void retire(void* p, void (*deleter)(void*)) {
+		record&        r = m_records.local();
+		const uint64_t e = m_epoch.load(std::memory_order_seq_cst);
+		bag&           b = r.bags[e % 3];
+		if(b.epoch != e) { // Retired 3 or more epochs ago, so safe
+			r.pending -= b.objects.size();
+			b.free();
+			b.epoch = e;
+		}
+		b.objects.push_back({p, deleter});
+		++r.pending;
+		DA_IFUNLIKELY(++r.unscanned == batch_size) {
+			r.unscanned = 0;
+			try_advance();
+			_M_collect(r);
+		}
+	}
+
+	/// Delete @param p once no pinned thread can be reading it
+	template<typename T>
+	void retire(T* p) {
+		retire(const_cast<void*>(static_cast<const void*>(p)), [](void* q) { delete static_cast<T*>(q); });
+	}
+
+	/**
+	 * @brief  Advance the global epoch if every pinned thread has seen the current one
+	 * @return Whether the epoch is advanced, by this thread or another
+	 */
+	bool try_advance() noexcept {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		uint64_t e       = m_epoch.load(std::memory_order_relaxed);
+		bool     blocked = false;
+		m_records.for_each([&](const record& r) {
+			const uint64_t s = r.state.load(std::memory_order_relaxed);
+			blocked          = blocked || ((s & 1) != 0 && (s >> 1) != e);
+		});
+		if(blocked) {
+			return false;
+		}
+		std::atomic_thread_fence(std::memory_order_acquire); // The unpinned threads are done with the objects
+		m_epoch.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst); // Fails only if advanced by another thread
+		return true;
+	}
+
+	/// Free the objects retired by the calling thread that are safe now
+	void collect() {
+		_M_collect(m_records.local());
+	}
+
+	/**
+	 * @brief Wait until all objects retired by the calling thread are freed
+	 * @note  The calling thread must not be pinned, and it spins while other threads stay pinned
+	 */
+	void synchronize() {
+		record& r = m_records.local();
+		DA_ASSERT(r.pins == 0);
+		while(r.pending != 0) {
+			if(!try_advance()) {
+				std::this_thread::yield();
+			}
+			_M_collect(r);
+		}
+	}
+
+	public: // Observers
+	[[nodiscard]] uint64_t epoch() const noexcept {
+		return m_epoch.load(std::memory_order_relaxed);
+	}
+
+	/// The number of objects retired by the calling thread & not freed yet
+	[[nodiscard]] size_t pending() {
+		return m_records.local().pending;
+	}
+
+	private: // Internal functions
+	void _M_unpin(record& r) noexcept {
+		DA_ASSERT(r.pins != 0);
+		DA_IFLIKELY(--r.pins == 0) {
+			r.state.store(0, std::memory_order_release); // The reads of the shared objects end before
+		}
+	}
+
+	void _M_collect(record& r) noexcept {
+		const uint64_t e = m_epoch.load(std::memory_order_acquire);
+		for(bag& b : r.bags) {
+			if(!b.objects.empty() && b.epoch + 2 <= e) {
+				r.pending -= b.objects.size();
+				b.free();
+			}
+		}
+	}
+
+	std::atomic<uint64_t> m_epoch{1};
+	per_thread<record>    m_records;
+};
+
+/// The domain shared by the structures of the library & those not needing one of their own
+[[nodiscard]] inline epoch_domain& default_epoch_domain() noexcept {
+	static epoch_domain domain;
+	return domain;
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_CONCURRENCY_EPOCH_HPP_
@@ -0,0 +1,109 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      per_thread.hpp
+ * @brief     A separate value for each thread
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONCURRENCY_PER_THREAD_HPP_
+#define _DA_CONCURRENCY_PER_THREAD_HPP_
+
+#include <da/config.hpp>
+#include <da/concurrency/thread_index.hpp>
+#include <da/memory/cache_aligned.hpp>
+#include <atomic>
+#include <bit> // for std::bit_width()
+#include <utility>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief  A @tparam T for each thread, indexed by thread_index() & each in its own cache lines
+ * @note   A thread uses the value left by an exited thread with the same index, so nothing is lost,
+ *         e.g. for counters. The values are value-initialized when created
+ * @note   for_each() may run concurrently with the threads using local(),
+ *         so T should be an atomic or others safe to be read then
+ */
+template<typename T>
+class per_thread {
+	typedef cache_aligned<T> slot;
+
+	// Slots are allocated in segments of doubling size, so they never move and can be read without locking
+	static inline constexpr size_t first_segment_bits = 3;
+	static inline constexpr size_t segment_count      = 30; // Enough for any number of threads
+
+	public:
+	typedef T value_type;
+
+	public: // Constructors
+	per_thread() noexcept = default;
+
+	per_thread(const per_thread&)            = delete;
+	per_thread& operator=(const per_thread&) = delete;
+
+	~per_thread() {
+		for(auto& s : m_segments) {
+			delete[] s.load(std::memory_order_relaxed);
+		}
+	}
+
+	public: // Access
+	/// The value of the calling thread
+	[[nodiscard]] T& local() {
+		const auto [k, offset] = _S_locate(thread_index());
+		slot* seg              = m_segments[k].load(std::memory_order_acquire);
+		DA_IFUNLIKELY(seg == nullptr) {
+			seg = _M_new_segment(k);
+		}
+		return seg[offset].value;
+	}
+
+	/// Call @param f with the value of each index, including those not used yet (value-initialized)
+	template<typename F>
+	void for_each(F&& f) {
+		_S_for_each(*this, f);
+	}
+
+	template<typename F>
+	void for_each(F&& f) const {
+		_S_for_each(*this, f);
+	}
+
+	private: // Internal functions
+	/// Return {segment, offset in segment} of @param i
+	static std::pair<size_t, size_t> _S_locate(size_t i) noexcept {
+		const size_t k = std::bit_width((i >> first_segment_bits) + 1) - 1;
+		return {k, i - (((size_t(1) << k) - 1) << first_segment_bits)};
+	}
+
+	slot* _M_new_segment(size_t k) {
+		slot* seg      = new slot[size_t(1) << (first_segment_bits + k)]();
+		slot* expected = nullptr;
+		if(!m_segments[k].compare_exchange_strong(expected, seg, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			delete[] seg; // Created by another thread
+			seg = expected;
+		}
+		return seg;
+	}
+
+	template<typename Self, typename F>
+	static void _S_for_each(Self& self, F& f) {
+		for(size_t k = 0; k < segment_count; ++k) {
+			auto* const seg = self.m_segments[k].load(std::memory_order_acquire);
+			if(seg != nullptr) {
+				for(size_t i = 0, n = size_t(1) << (first_segment_bits + k); i < n; ++i) {
+					f(seg[i].value);
+				}
+			}
+		}
+	}
+
+	std::atomic<slot*> m_segments[segment_count] = {};
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_CONCURRENCY_PER_THREAD_HPP_
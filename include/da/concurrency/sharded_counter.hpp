@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      sharded_counter.hpp
+ * @brief     A counter updated by many threads without contention
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONCURRENCY_SHARDED_COUNTER_HPP_
+#define _DA_CONCURRENCY_SHARDED_COUNTER_HPP_
+
+#include <da/config.hpp>
+#include <da/concurrency/per_thread.hpp>
+#include <atomic>
+#include <cstdint>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A counter with a shard for each thread, summed up by load()
+ * @note  Each shard is only written by its own thread, so add() is a plain load & store
+ *        on a cache line never shared, instead of a locked read-modify-write on a shared one
+ * @note  load() is not a snapshot, the additions racing with it may or may not be counted
+ */
+class sharded_counter {
+	per_thread<std::atomic<uint64_t>> m_shards;
+
+	public:
+	sharded_counter() noexcept = default;
+
+	void add(uint64_t n = 1) {
+		std::atomic<uint64_t>& s = m_shards.local();
+		s.store(s.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	sharded_counter& operator+=(uint64_t n) {
+		add(n);
+		return *this;
+	}
+
+	sharded_counter& operator++() {
+		add(1);
+		return *this;
+	}
+
+	[[nodiscard]] uint64_t load() const noexcept {
+		uint64_t sum = 0;
+		m_shards.for_each([&](const std::atomic<uint64_t>& s) {
+			sum += s.load(std::memory_order_relaxed);
+		});
+		return sum;
+	}
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_CONCURRENCY_SHARDED_COUNTER_HPP_
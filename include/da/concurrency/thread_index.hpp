@@ -0,0 +1,95 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      thread_index.hpp
+ * @brief     Small dense indexes of threads
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONCURRENCY_THREAD_INDEX_HPP_
+#define _DA_CONCURRENCY_THREAD_INDEX_HPP_
+
+#include <da/config.hpp>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+DA_BEGIN_DETAIL
+
+/// Hands out the smallest free indexes, those of exited threads are reused
+class thread_index_registry {
+	std::mutex            m_mutex;
+	std::vector<uint32_t> m_free; // Guarded by m_mutex
+	uint32_t              m_next = 0;
+
+	public:
+	constexpr thread_index_registry() noexcept = default;
+
+	uint32_t acquire() {
+		std::lock_guard lock(m_mutex);
+		if(m_free.empty()) {
+			return m_next++;
+		}
+		const uint32_t i = m_free.back();
+		m_free.pop_back();
+		return i;
+	}
+
+	void release(uint32_t i) noexcept {
+		std::lock_guard lock(m_mutex);
+		DA_TRY {
+			m_free.push_back(i);
+		}
+		DA_CATCH(...) { } // Lost, only the indexes grow larger
+	}
+};
+
+inline constinit thread_index_registry thread_indexes{};
+
+class thread_index_holder {
+	static inline constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+	uint32_t m_index = none;
+
+	public:
+	constexpr thread_index_holder() noexcept = default;
+
+	thread_index_holder(const thread_index_holder&)            = delete;
+	thread_index_holder& operator=(const thread_index_holder&) = delete;
+
+	~thread_index_holder() {
+		if(m_index != none) {
+			thread_indexes.release(m_index);
+			m_index = none;
+		}
+	}
+
+	uint32_t get() {
+		DA_IFUNLIKELY(m_index == none) {
+			m_index = thread_indexes.acquire();
+		}
+		return m_index;
+	}
+};
+
+inline thread_local thread_index_holder thread_index_of_this{};
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief The index of the calling thread, unique among the running threads
+ * @note  Indexes are dense & start from 0, the index of an exited thread is given to the next new thread,
+ *        so they can index arrays of per-thread data
+ */
+[[nodiscard]] inline uint32_t thread_index() {
+	return _DA_DETAIL thread_index_of_this.get();
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_CONCURRENCY_THREAD_INDEX_HPP_
@@ -45,6 +45,60 @@
 	#define DA_CPPVER __cplusplus
 #endif
 
+/// Detect platform
+#if defined(_WIN32)
+	#define DA_WINDOWS 1
+#else
+	#define DA_WINDOWS 0
+#endif
+
+#if defined(__linux__)
+	#define DA_LINUX 1
+#else
+	#define DA_LINUX 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+	#define DA_UNIX 1
+#else
+	#define DA_UNIX 0
+#endif
+
+/// Detect instruction set extensions
+/// MSVC doesn't define __SSE2__ etc, x64 always has SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define DA_HAS_SSE2 1
+#else
+	#define DA_HAS_SSE2 0
+#endif
+
+/// MSVC only defines __AVX__ & above
+#if defined(__SSSE3__) || defined(__AVX__)
+	#define DA_HAS_SSSE3 1
+#else
+	#define DA_HAS_SSSE3 0
+#endif
+
+#if defined(__AVX2__)
+	#define DA_HAS_AVX2 1
+#else
+	#define DA_HAS_AVX2 0
+#endif
+
+/// Foundation & doubleword/quadword instructions, which all AVX-512 CPUs have
+#if defined(__AVX512F__) && defined(__AVX512DQ__)
+	#define DA_HAS_AVX512 1
+#else
+	#define DA_HAS_AVX512 0
+#endif
+
+/// Detect native 128-bit integer
+#if defined(__SIZEOF_INT128__)
+	#define DA_HAS_INT128 1
+#else
+	#define DA_HAS_INT128 0
+#endif
+
 /// Verify we have at least C++20
 #if DA_CPPVER < 202002L
 	#error DA should be compiled under at least C++20
@@ -0,0 +1,19 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      container.hpp
+ * @brief     Containers
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONTAINER_HPP_
+#define _DA_CONTAINER_HPP_
+
+#include <da/config.hpp>
+#include <da/container/fixed_point_column.hpp>
+#include <da/container/small_vector.hpp>
+#include <da/container/vector.hpp>
+
+#endif // _DA_CONTAINER_HPP_
@@ -0,0 +1,289 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      fixed_point_column.hpp
+ * @brief     A column of fixed_point compressed by frame-of-reference blocks
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONTAINER_FIXED_POINT_COLUMN_HPP_
+#define _DA_CONTAINER_FIXED_POINT_COLUMN_HPP_
+
+#include <da/config.hpp>
+#include <da/concepts.hpp>
+#include <da/format.hpp>
+#include <da/container/vector.hpp>
+#include <da/utility/batch.hpp>
+#include <da/utility/number.hpp>
+#include <algorithm>
+#include <bit>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief An append-only column of fixed_point<Precision, Base>, stored in blocks of block_size values.
+ *        Each full block keeps its minimum as the frame of reference and the offsets from it
+ *        in the narrowest of 0, 1, 2, 4 or 8 bytes, e.g. prices or timestamps close to each other
+ *        take 1 or 2 bytes per value instead of 8
+ * @note  The minimum & maximum of each block are kept, so that min() & max() never decode the values,
+ *        and sum() adds the narrow offsets directly
+ * @note  The decoding loops are simple widening additions over a constant length, left to the auto-vectorizer
+ * @note  The values not filling a block are kept uncompressed
+ */
+template<size_t Precision, integral Base = int64_t>
+class fixed_point_column {
+	typedef fixed_point_column<Precision, Base> Self;
+	typedef std::make_unsigned_t<Base>          unsigned_type;
+
+	static_assert(sizeof(Base) <= 8, "Only Base of at most 64 bits is supported");
+
+	public:
+	typedef fixed_point<Precision, Base> value_type;
+	typedef size_t                       size_type;
+
+	static inline constexpr size_type block_size = 1024;
+
+	private:
+	struct block {
+		Base      min;
+		Base      max;
+		size_type offset; // In offsets of the payload of its width
+		uint8_t   width;  // Bytes of each offset from min
+	};
+
+	// One payload per width, so that the offsets are always accessed by their own type
+	typedef std::tuple<vector<uint8_t>, vector<uint16_t>, vector<uint32_t>, vector<uint64_t>> payloads;
+
+	vector<block> m_blocks;
+	payloads      m_payloads;
+	vector<Base>  m_tail; // Less than block_size values
+
+	public: // Constructors
+	fixed_point_column() = default;
+
+	fixed_point_column(std::initializer_list<value_type> il) {
+		append(std::span<const value_type>(il.begin(), il.size()));
+	}
+
+	explicit fixed_point_column(std::span<const value_type> values) {
+		append(values);
+	}
+
+	public: // Capacity
+	[[nodiscard]] DA_CONSTEXPR size_type size() const noexcept {
+		return m_blocks.size() * block_size + m_tail.size();
+	}
+
+	[[nodiscard]] DA_CONSTEXPR bool empty() const noexcept {
+		return size() == 0;
+	}
+
+	/// The bytes used by the values, excluding the unused capacity
+	[[nodiscard]] DA_CONSTEXPR size_type memory_usage() const noexcept {
+		const size_type payload = std::apply([](const auto&... p) { return ((p.size() * sizeof(p[0])) + ...); }, m_payloads);
+		return m_blocks.size() * sizeof(block) + payload + m_tail.size() * sizeof(Base);
+	}
+
+	public: // Element access
+	[[nodiscard]] value_type operator[](size_type n) const noexcept {
+		DA_ASSERT(n < size());
+		const size_type b = n / block_size;
+		if(b == m_blocks.size()) {
+			return value_type::from_raw(m_tail[n % block_size]);
+		}
+		const block& blk = m_blocks[b];
+		return value_type::from_raw(_S_visit(blk.width, [&]<typename U>(U) {
+			return _S_add(blk.min, _M_offsets<U>(blk)[n % block_size]);
+		}));
+	}
+
+	[[nodiscard]] value_type at(size_type n) const {
+		DA_IFUNLIKELY(n >= size()) {
+			DA_THROW(std::out_of_range(fmt::format("da::fixed_point_column::at: n (which is {}) >= this->size() (which is {})", n, size())));
+		}
+		return (*this)[n];
+	}
+
+	public: // Modifiers
+	void push_back(value_type v) {
+		m_tail.push_back(v.raw());
+		DA_IFUNLIKELY(m_tail.size() == block_size) {
+			_M_seal();
+		}
+	}
+
+	void append(std::span<const value_type> values) {
+		for(const value_type& v : values) {
+			push_back(v);
+		}
+	}
+
+	void clear() noexcept {
+		m_blocks.clear();
+		std::apply([](auto&... p) { (p.clear(), ...); }, m_payloads);
+		m_tail.clear();
+	}
+
+	public: // Scan
+	/**
+	 * @brief Decode the values block by block and call @param f with a std::span<const value_type> of each,
+	 *        including the uncompressed tail
+	 * @note  The span is only valid during the call
+	 */
+	template<invocable<std::span<const value_type>> Func>
+	void scan(Func f) const {
+		value_type buf[block_size];
+		for(const block& blk : m_blocks) {
+			Base* const out = _DA_DETAIL raw_data(buf);
+			_S_visit(blk.width, [&]<typename U>(U) {
+				const auto d = _M_offsets<U>(blk);
+				for(size_type i = 0; i < block_size; ++i) {
+					out[i] = _S_add(blk.min, d[i]);
+				}
+				return 0;
+			});
+			f(std::span<const value_type>(buf, block_size));
+		}
+		if(!m_tail.empty()) {
+			f(_M_tail_span());
+		}
+	}
+
+	/**
+	 * @brief  The sum of all values, accumulated in 128 bits like da::sum()
+	 * @note   Each block adds block_size * min and the sum of its narrow offsets
+	 * @throw  std::overflow_error if the sum doesn't fit in the Base
+	 */
+	[[nodiscard]] value_type sum() const {
+		_DA_DETAIL wide_sum s;
+		for(const block& blk : m_blocks) {
+			s.add(blk.min, block_size);
+			_S_visit(blk.width, [&]<typename U>(U) {
+				const auto d = _M_offsets<U>(blk);
+				if constexpr(std::is_same_v<U, empty_offsets>) {
+					// Nothing to add
+				} else if constexpr(sizeof(U) < 8) { // block_size * 2^32 never overflows
+					uint64_t t = 0;
+					for(size_type i = 0; i < block_size; ++i) {
+						t += d[i];
+					}
+					s.add(t);
+				} else {
+					for(size_type i = 0; i < block_size; ++i) {
+						s.add(d[i]);
+					}
+				}
+				return 0;
+			});
+		}
+		for(Base x : m_tail) {
+			s.add(x);
+		}
+		Base r{};
+		DA_IFUNLIKELY(!s.get(r)) {
+			DA_THROW(std::overflow_error("da::fixed_point_column::sum: The sum doesn't fit in the Base type"));
+		}
+		return value_type::from_raw(r);
+	}
+
+	/// The minimum, from the block headers & the tail only, the column must not be empty
+	[[nodiscard]] value_type min() const noexcept {
+		return _M_extreme<false>();
+	}
+
+	/// The maximum, from the block headers & the tail only, the column must not be empty
+	[[nodiscard]] value_type max() const noexcept {
+		return _M_extreme<true>();
+	}
+
+	private: // Internal functions
+	/// Call @param f with a value of the offset type of @param width, 0 for all the same
+	template<typename Func>
+	static DA_CONSTEXPR Base _S_visit(uint8_t width, Func f) noexcept {
+		switch(width) {
+			case 0: return static_cast<Base>(f(empty_offsets{}));
+			case 1: return static_cast<Base>(f(uint8_t{}));
+			case 2: return static_cast<Base>(f(uint16_t{}));
+			case 4: return static_cast<Base>(f(uint32_t{}));
+			default: return static_cast<Base>(f(uint64_t{}));
+		}
+	}
+
+	/// The offsets of a block whose values are all the same, which takes no space
+	struct empty_offsets {
+		DA_CONSTEXPR unsigned_type operator[](size_type) const noexcept {
+			return 0;
+		}
+	};
+
+	template<typename U>
+	auto _M_offsets(const block& blk) const noexcept {
+		if constexpr(std::is_same_v<U, empty_offsets>) {
+			return empty_offsets{};
+		} else {
+			return std::get<vector<U>>(m_payloads).data() + blk.offset;
+		}
+	}
+
+	template<typename U>
+	static DA_CONSTEXPR Base _S_add(Base min, U offset) noexcept {
+		return static_cast<Base>(static_cast<unsigned_type>(min) + static_cast<unsigned_type>(offset));
+	}
+
+	/// Compress the full tail into a block
+	void _M_seal() {
+		DA_ASSERT(m_tail.size() == block_size);
+		const auto [lo, hi] = std::minmax_element(m_tail.begin(), m_tail.end());
+
+		block blk{*lo, *hi, 0, 0};
+		// The narrowest of 1, 2, 4 & 8 bytes holding max - min
+		const auto range = static_cast<unsigned_type>(static_cast<unsigned_type>(blk.max) - static_cast<unsigned_type>(blk.min));
+		if(range != 0) {
+			blk.width = static_cast<uint8_t>(std::bit_ceil((std::bit_width(range) + 7) / 8u));
+		}
+		if(blk.width != 0) {
+			_S_visit(blk.width, [&]<typename U>(U) {
+				if constexpr(!std::is_same_v<U, empty_offsets>) {
+					vector<U>& payload = std::get<vector<U>>(m_payloads);
+					blk.offset         = payload.size();
+					payload.resize(payload.size() + block_size);
+					U* const d = payload.data() + blk.offset;
+					for(size_type i = 0; i < block_size; ++i) {
+						d[i] = static_cast<U>(static_cast<unsigned_type>(m_tail[i]) - static_cast<unsigned_type>(blk.min));
+					}
+				}
+				return 0;
+			});
+		}
+		m_blocks.push_back(blk);
+		m_tail.clear();
+	}
+
+	std::span<const value_type> _M_tail_span() const noexcept {
+		static_assert(sizeof(value_type) == sizeof(Base), "fixed_point should have the same layout as its Base");
+		return {reinterpret_cast<const value_type*>(m_tail.data()), m_tail.size()};
+	}
+
+	template<bool Max>
+	value_type _M_extreme() const noexcept {
+		DA_ASSERT(!empty());
+		auto pick = [](Base a, Base b) { return Max ? std::max(a, b) : std::min(a, b); };
+		Base m    = m_blocks.empty() ? m_tail[0] : (Max ? m_blocks[0].max : m_blocks[0].min);
+		for(const block& blk : m_blocks) {
+			m = pick(m, Max ? blk.max : blk.min);
+		}
+		if(!m_tail.empty()) {
+			m = pick(m, Max ? _DA max(_M_tail_span()).raw() : _DA min(_M_tail_span()).raw());
+		}
+		return value_type::from_raw(m);
+	}
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_CONTAINER_FIXED_POINT_COLUMN_HPP_
@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      small_vector.hpp
+ * @brief     A vector keeping a few elements inline
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONTAINER_SMALL_VECTOR_HPP_
+#define _DA_CONTAINER_SMALL_VECTOR_HPP_
+
+#include <da/config.hpp>
+#include <da/container/vector.hpp>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A da::vector keeping the first @tparam N elements in itself, only allocating for more
+ * @note  It falls back to the inline elements again by shrink_to_fit() if they are enough
+ * @note  Moving or swapping relocates the inline elements one by one (by a single memcpy if trivially relocatable),
+ *        so unlike da::vector, iterators are invalidated and it is not trivially relocatable itself
+ */
+template<typename T, size_t N, typename Alloc = std::allocator<T>>
+class small_vector : public _DA_DETAIL basic_vector<T, Alloc, N> {
+	static_assert(N != 0, "da::small_vector: Use da::vector instead");
+
+	public:
+	static inline constexpr size_t inline_capacity = N;
+
+	using _DA_DETAIL basic_vector<T, Alloc, N>::basic_vector;
+	using _DA_DETAIL basic_vector<T, Alloc, N>::operator=;
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_CONTAINER_SMALL_VECTOR_HPP_
@@ -0,0 +1,808 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      vector.hpp
+ * @brief     A vector relocating trivially relocatable elements by memcpy
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_CONTAINER_VECTOR_HPP_
+#define _DA_CONTAINER_VECTOR_HPP_
+
+#include <da/config.hpp>
+#include <da/format.hpp>
+#include <da/iterator.hpp>
+#include <da/memory/aligned_buffer.hpp>
+#include <da/memory/relocate.hpp>
+#include <da/type_traits/relocatable.hpp>
+#include <algorithm>
+#include <compare>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <utility>
+
+DA_BEGIN_DETAIL
+
+/// Hold the allocator by Empty-Base Optimization, and the first @tparam N elements inline
+template<typename T, typename Alloc, size_t N>
+struct vector_storage : Alloc {
+	T*                m_begin;
+	T*                m_end;
+	T*                m_cap;
+	aligned_buffer<T> m_inline[N]; // Not initialized
+
+	vector_storage() noexcept(noexcept(Alloc())) {
+		_M_reset();
+	}
+
+	explicit vector_storage(const Alloc& a) noexcept
+		: Alloc(a) {
+		_M_reset();
+	}
+
+	explicit vector_storage(Alloc&& a) noexcept
+		: Alloc(std::move(a)) {
+		_M_reset();
+	}
+
+	T* _M_inline() noexcept {
+		return m_inline[0].ptr();
+	}
+
+	bool _M_is_inline(const T* p) const noexcept {
+		return p == m_inline[0].ptr();
+	}
+
+	void _M_reset() noexcept {
+		m_begin = m_end = _M_inline();
+		m_cap           = m_begin + N;
+	}
+};
+
+template<typename T, typename Alloc>
+struct vector_storage<T, Alloc, 0> : Alloc {
+	T* m_begin = nullptr;
+	T* m_end   = nullptr;
+	T* m_cap   = nullptr;
+
+	vector_storage() noexcept(noexcept(Alloc())) = default;
+
+	explicit vector_storage(const Alloc& a) noexcept
+		: Alloc(a) { }
+
+	explicit vector_storage(Alloc&& a) noexcept
+		: Alloc(std::move(a)) { }
+
+	T* _M_inline() noexcept {
+		return nullptr;
+	}
+
+	bool _M_is_inline(const T*) const noexcept {
+		return false;
+	}
+
+	void _M_reset() noexcept {
+		m_begin = m_end = m_cap = nullptr;
+	}
+};
+
+/// The implementation of da::vector & da::small_vector, keeping the first @tparam N elements inline
+template<typename T, typename Alloc, size_t N>
+class basic_vector {
+	typedef basic_vector<T, Alloc, N>              Self;
+	typedef std::allocator_traits<Alloc>           alloc_traits;
+	typedef _DA_DETAIL vector_storage<T, Alloc, N> storage_type;
+
+	static_assert(std::is_same_v<typename alloc_traits::value_type, T>, "da::vector: Alloc::value_type must be T");
+	static_assert(std::is_same_v<typename alloc_traits::pointer, T*>, "da::vector: Only allocators using raw pointers are supported");
+
+	static inline constexpr bool relocatable = is_trivially_relocatable_v<T>;
+	// Moving the inline elements of another vector
+	static inline constexpr bool nothrow_steal = N == 0 || relocatable || std::is_nothrow_move_constructible_v<T>;
+
+	public:
+	typedef T                                      value_type;
+	typedef Alloc                                  allocator_type;
+	typedef typename alloc_traits::size_type       size_type;
+	typedef typename alloc_traits::difference_type difference_type;
+	typedef T&                                     reference;
+	typedef const T&                               const_reference;
+	typedef T*                                     pointer;
+	typedef const T*                               const_pointer;
+	typedef T*                                     iterator;
+	typedef const T*                               const_iterator;
+	typedef std::reverse_iterator<iterator>        reverse_iterator;
+	typedef std::reverse_iterator<const_iterator>  const_reverse_iterator;
+
+	public: // Constructors
+	basic_vector() noexcept(noexcept(Alloc())) = default;
+
+	explicit basic_vector(const allocator_type& a) noexcept
+		: m_impl(a) { }
+
+	explicit basic_vector(size_type n, const allocator_type& a = allocator_type())
+		: m_impl(a) {
+		_M_init(n, [&](pointer p) { return std::uninitialized_value_construct_n(p, n); });
+	}
+
+	basic_vector(size_type n, const value_type& v, const allocator_type& a = allocator_type())
+		: m_impl(a) {
+		_M_init(n, [&](pointer p) { return std::uninitialized_fill_n(p, n, v); });
+	}
+
+	template<forward_iterator Iter>
+	basic_vector(Iter first, Iter last, const allocator_type& a = allocator_type())
+		: m_impl(a) {
+		_M_init(static_cast<size_type>(std::distance(first, last)), [&](pointer p) { return std::uninitialized_copy(first, last, p); });
+	}
+
+	template<input_iterator Iter>
+	basic_vector(Iter first, Iter last, const allocator_type& a = allocator_type())
+		: m_impl(a) {
+		DA_TRY {
+			for(; first != last; ++first) {
+				emplace_back(*first);
+			}
+		}
+		DA_CATCH(...) {
+			_M_release();
+			DA_THROW_AGAIN();
+		}
+	}
+
+	basic_vector(std::initializer_list<value_type> il, const allocator_type& a = allocator_type())
+		: basic_vector(il.begin(), il.end(), a) { }
+
+	basic_vector(const Self& v)
+		: basic_vector(v, alloc_traits::select_on_container_copy_construction(v.get_allocator())) { }
+
+	basic_vector(const Self& v, const allocator_type& a)
+		: m_impl(a) {
+		_M_init(v.size(), [&](pointer p) { return std::uninitialized_copy(v.begin(), v.end(), p); });
+	}
+
+	basic_vector(Self&& v) noexcept(nothrow_steal)
+		: m_impl(std::move(v._M_get_alloc())) {
+		_M_steal(v);
+	}
+
+	~basic_vector() {
+		_M_release();
+	}
+
+	public: // Assignment
+	Self& operator=(const Self& v) {
+		if(this == &v) {
+			return *this;
+		}
+		if constexpr(alloc_traits::propagate_on_container_copy_assignment::value) {
+			if(!alloc_traits::is_always_equal::value && _M_get_alloc() != v._M_get_alloc()) {
+				_M_release(); // The memory must be freed by the old allocator
+			}
+			_M_get_alloc() = v._M_get_alloc();
+		}
+		assign(v.begin(), v.end());
+		return *this;
+	}
+
+	Self& operator=(Self&& v) noexcept(nothrow_steal && (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)) {
+		if(this == &v) {
+			return *this;
+		}
+		if constexpr(alloc_traits::propagate_on_container_move_assignment::value) {
+			_M_release();
+			_M_get_alloc() = std::move(v._M_get_alloc());
+			_M_steal(v);
+		} else {
+			if(alloc_traits::is_always_equal::value || _M_get_alloc() == v._M_get_alloc()) {
+				_M_release();
+				_M_steal(v);
+			} else { // Cannot take the memory of another allocator
+				assign(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+				v.clear();
+			}
+		}
+		return *this;
+	}
+
+	Self& operator=(std::initializer_list<value_type> il) {
+		assign(il.begin(), il.end());
+		return *this;
+	}
+
+	void assign(size_type n, const value_type& v) {
+		if(n > capacity()) {
+			Self tmp(n, v, _M_get_alloc());
+			swap(tmp);
+			return;
+		}
+		const size_type s = size();
+		std::fill_n(m_impl.m_begin, std::min(n, s), v);
+		if(n > s) {
+			m_impl.m_end = std::uninitialized_fill_n(m_impl.m_end, n - s, v);
+		} else {
+			_M_erase_at_end(m_impl.m_begin + n);
+		}
+	}
+
+	template<forward_iterator Iter>
+	void assign(Iter first, Iter last) {
+		const auto n = static_cast<size_type>(std::distance(first, last));
+		if(n > capacity()) {
+			Self tmp(first, last, _M_get_alloc());
+			swap(tmp);
+			return;
+		}
+		const size_type s = size();
+		if(n > s) {
+			Iter mid = std::next(first, static_cast<difference_type>(s));
+			std::copy(first, mid, m_impl.m_begin);
+			m_impl.m_end = std::uninitialized_copy(mid, last, m_impl.m_end);
+		} else {
+			_M_erase_at_end(std::copy(first, last, m_impl.m_begin));
+		}
+	}
+
+	template<input_iterator Iter>
+	void assign(Iter first, Iter last) {
+		clear();
+		for(; first != last; ++first) {
+			emplace_back(*first);
+		}
+	}
+
+	void assign(std::initializer_list<value_type> il) {
+		assign(il.begin(), il.end());
+	}
+
+	allocator_type get_allocator() const noexcept {
+		return _M_get_alloc();
+	}
+
+	public: // Member access
+	DA_CONSTEXPR reference operator[](size_type n) noexcept {
+		DA_ASSERT(n < size());
+		return m_impl.m_begin[n];
+	}
+
+	DA_CONSTEXPR const_reference operator[](size_type n) const noexcept {
+		DA_ASSERT(n < size());
+		return m_impl.m_begin[n];
+	}
+
+	DA_CONSTEXPR reference at(size_type n) {
+		_M_check_pos(n, "da::vector::at");
+		return m_impl.m_begin[n];
+	}
+
+	DA_CONSTEXPR const_reference at(size_type n) const {
+		_M_check_pos(n, "da::vector::at");
+		return m_impl.m_begin[n];
+	}
+
+	DA_CONSTEXPR reference front() noexcept {
+		DA_ASSERT(!empty());
+		return *m_impl.m_begin;
+	}
+
+	DA_CONSTEXPR const_reference front() const noexcept {
+		DA_ASSERT(!empty());
+		return *m_impl.m_begin;
+	}
+
+	DA_CONSTEXPR reference back() noexcept {
+		DA_ASSERT(!empty());
+		return *(m_impl.m_end - 1);
+	}
+
+	DA_CONSTEXPR const_reference back() const noexcept {
+		DA_ASSERT(!empty());
+		return *(m_impl.m_end - 1);
+	}
+
+	DA_CONSTEXPR pointer data() noexcept {
+		return m_impl.m_begin;
+	}
+
+	DA_CONSTEXPR const_pointer data() const noexcept {
+		return m_impl.m_begin;
+	}
+
+	public: // Iterators
+	DA_CONSTEXPR iterator begin() noexcept {
+		return m_impl.m_begin;
+	}
+
+	DA_CONSTEXPR const_iterator begin() const noexcept {
+		return m_impl.m_begin;
+	}
+
+	DA_CONSTEXPR iterator end() noexcept {
+		return m_impl.m_end;
+	}
+
+	DA_CONSTEXPR const_iterator end() const noexcept {
+		return m_impl.m_end;
+	}
+
+	DA_CONSTEXPR reverse_iterator rbegin() noexcept {
+		return reverse_iterator(end());
+	}
+
+	DA_CONSTEXPR const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+
+	DA_CONSTEXPR reverse_iterator rend() noexcept {
+		return reverse_iterator(begin());
+	}
+
+	DA_CONSTEXPR const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+	DA_CONSTEXPR const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	DA_CONSTEXPR const_iterator cend() const noexcept {
+		return end();
+	}
+
+	DA_CONSTEXPR const_reverse_iterator crbegin() const noexcept {
+		return rbegin();
+	}
+
+	DA_CONSTEXPR const_reverse_iterator crend() const noexcept {
+		return rend();
+	}
+
+	public: // Capacity
+	DA_CONSTEXPR bool empty() const noexcept {
+		return m_impl.m_begin == m_impl.m_end;
+	}
+
+	DA_CONSTEXPR size_type size() const noexcept {
+		return static_cast<size_type>(m_impl.m_end - m_impl.m_begin);
+	}
+
+	DA_CONSTEXPR size_type capacity() const noexcept {
+		return static_cast<size_type>(m_impl.m_cap - m_impl.m_begin);
+	}
+
+	DA_CONSTEXPR size_type max_size() const noexcept {
+		return std::min<size_type>(alloc_traits::max_size(_M_get_alloc()),
+								   std::numeric_limits<difference_type>::max() / sizeof(T));
+	}
+
+	void reserve(size_type n) {
+		DA_IFUNLIKELY(n > max_size()) {
+			DA_THROW(std::length_error(fmt::format("da::vector::reserve: n (which is {}) > max_size() (which is {})", n, max_size())));
+		}
+		if(n > capacity()) {
+			_M_reallocate(n, size(), 0, [](pointer) { });
+		}
+	}
+
+	void shrink_to_fit() {
+		if(m_impl._M_is_inline(m_impl.m_begin)) {
+			return;
+		}
+		if(empty()) {
+			_M_release();
+		} else if(size() < capacity()) { // Back to the inline elements if they are enough
+			_M_reallocate(size(), size(), 0, [](pointer) { });
+		}
+	}
+
+	public: // Modifiers
+	void clear() noexcept {
+		_M_erase_at_end(m_impl.m_begin);
+	}
+
+	template<typename... Args>
+	reference emplace_back(Args&&... args) {
+		DA_IFLIKELY(m_impl.m_end != m_impl.m_cap) {
+			std::construct_at(m_impl.m_end, std::forward<Args>(args)...);
+			++m_impl.m_end;
+		} else {
+			const size_type s = size();
+			_M_reallocate(_M_next_capacity(1), s, 1, [&](pointer p) {
+				std::construct_at(p, std::forward<Args>(args)...);
+			});
+		}
+		return back();
+	}
+
+	void push_back(const value_type& v) {
+		emplace_back(v);
+	}
+
+	void push_back(value_type&& v) {
+		emplace_back(std::move(v));
+	}
+
+	void pop_back() noexcept {
+		DA_ASSERT(!empty());
+		--m_impl.m_end;
+		std::destroy_at(m_impl.m_end);
+	}
+
+	template<typename... Args>
+	iterator emplace(const_iterator pos, Args&&... args) {
+		const size_type off = _M_offset(pos);
+		if(m_impl.m_end == m_impl.m_cap) {
+			_M_reallocate(_M_next_capacity(1), off, 1, [&](pointer p) {
+				std::construct_at(p, std::forward<Args>(args)...);
+			});
+		} else if constexpr(relocatable) {
+			// Construct aside first since args may refer to the elements to be moved
+			aligned_buffer<T> tmp(nullptr);
+			T* const          t = std::construct_at(static_cast<T*>(tmp.addr()), std::forward<Args>(args)...);
+			pointer const     p = m_impl.m_begin + off;
+			uninitialized_relocate_n(p, size() - off, p + 1);
+			relocate_at(t, p);
+			++m_impl.m_end;
+		} else {
+			std::construct_at(m_impl.m_end, std::forward<Args>(args)...);
+			++m_impl.m_end;
+			std::rotate(m_impl.m_begin + off, m_impl.m_end - 1, m_impl.m_end);
+		}
+		return m_impl.m_begin + off;
+	}
+
+	iterator insert(const_iterator pos, const value_type& v) {
+		return emplace(pos, v);
+	}
+
+	iterator insert(const_iterator pos, value_type&& v) {
+		return emplace(pos, std::move(v));
+	}
+
+	iterator insert(const_iterator pos, size_type n, const value_type& v) {
+		const size_type off = _M_offset(pos);
+		DA_IFUNLIKELY(n == 0) {
+			return m_impl.m_begin + off;
+		}
+		if(n > capacity() - size()) {
+			_M_reallocate(_M_next_capacity(n), off, n, [&](pointer p) {
+				std::uninitialized_fill_n(p, n, v);
+			});
+		} else if(&v >= m_impl.m_begin && &v < m_impl.m_end) { // v will be moved
+			const value_type tmp(v);
+			_M_insert_in_place(off, n, [&](pointer p) {
+				std::uninitialized_fill_n(p, n, tmp);
+			});
+		} else {
+			_M_insert_in_place(off, n, [&](pointer p) {
+				std::uninitialized_fill_n(p, n, v);
+			});
+		}
+		return m_impl.m_begin + off;
+	}
+
+	/// [first, last) must not be a part of this vector
+	template<forward_iterator Iter>
+	iterator insert(const_iterator pos, Iter first, Iter last) {
+		const size_type off = _M_offset(pos);
+		const auto      n   = static_cast<size_type>(std::distance(first, last));
+		DA_IFUNLIKELY(n == 0) {
+			return m_impl.m_begin + off;
+		}
+		if(n > capacity() - size()) {
+			_M_reallocate(_M_next_capacity(n), off, n, [&](pointer p) {
+				std::uninitialized_copy(first, last, p);
+			});
+		} else {
+			_M_insert_in_place(off, n, [&](pointer p) {
+				std::uninitialized_copy(first, last, p);
+			});
+		}
+		return m_impl.m_begin + off;
+	}
+
+	template<input_iterator Iter>
+	iterator insert(const_iterator pos, Iter first, Iter last) {
+		const size_type off = _M_offset(pos);
+		const size_type s   = size();
+		for(; first != last; ++first) {
+			emplace_back(*first);
+		}
+		std::rotate(m_impl.m_begin + off, m_impl.m_begin + s, m_impl.m_end);
+		return m_impl.m_begin + off;
+	}
+
+	iterator insert(const_iterator pos, std::initializer_list<value_type> il) {
+		return insert(pos, il.begin(), il.end());
+	}
+
+	iterator erase(const_iterator pos) {
+		DA_ASSERT(pos != end());
+		return erase(pos, pos + 1);
+	}
+
+	iterator erase(const_iterator first, const_iterator last) {
+		pointer const f = m_impl.m_begin + _M_offset(first);
+		pointer const l = m_impl.m_begin + _M_offset(last);
+		DA_IFUNLIKELY(f == l) {
+			return f;
+		}
+		if constexpr(relocatable) {
+			std::destroy(f, l);
+			uninitialized_relocate(l, m_impl.m_end, f);
+			m_impl.m_end -= l - f;
+		} else {
+			_M_erase_at_end(std::move(l, m_impl.m_end, f));
+		}
+		return f;
+	}
+
+	void resize(size_type n) {
+		const size_type s = size();
+		if(n < s) {
+			_M_erase_at_end(m_impl.m_begin + n);
+		} else if(n > s) {
+			if(n > capacity()) {
+				_M_reallocate(_M_next_capacity(n - s), s, n - s, [&](pointer p) {
+					std::uninitialized_value_construct_n(p, n - s);
+				});
+			} else {
+				m_impl.m_end = std::uninitialized_value_construct_n(m_impl.m_end, n - s);
+			}
+		}
+	}
+
+	void resize(size_type n, const value_type& v) {
+		const size_type s = size();
+		if(n < s) {
+			_M_erase_at_end(m_impl.m_begin + n);
+		} else if(n > s) {
+			insert(end(), n - s, v);
+		}
+	}
+
+	void swap(Self& v) noexcept(nothrow_steal) {
+		using std::swap;
+		if constexpr(alloc_traits::propagate_on_container_swap::value) {
+			swap(_M_get_alloc(), v._M_get_alloc());
+		} else {
+			DA_ASSERT(alloc_traits::is_always_equal::value || _M_get_alloc() == v._M_get_alloc());
+		}
+		if constexpr(N != 0) {
+			if(m_impl._M_is_inline(m_impl.m_begin) || v.m_impl._M_is_inline(v.m_impl.m_begin)) {
+				Self tmp(_M_get_alloc()); // Never frees, since it is empty at last
+				tmp._M_steal(*this);
+				_M_steal(v);
+				v._M_steal(tmp);
+				return;
+			}
+		}
+		swap(m_impl.m_begin, v.m_impl.m_begin);
+		swap(m_impl.m_end, v.m_impl.m_end);
+		swap(m_impl.m_cap, v.m_impl.m_cap);
+	}
+
+	friend void swap(Self& a, Self& b) noexcept(nothrow_steal) {
+		a.swap(b);
+	}
+
+	friend bool operator==(const Self& a, const Self& b) {
+		return std::equal(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	friend auto operator<=>(const Self& a, const Self& b) {
+		return std::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+	}
+
+	private: // Internal functions
+	DA_CONSTEXPR allocator_type& _M_get_alloc() noexcept {
+		return m_impl;
+	}
+
+	DA_CONSTEXPR const allocator_type& _M_get_alloc() const noexcept {
+		return m_impl;
+	}
+
+	DA_CONSTEXPR void _M_check_pos(size_type n, const char* what) const {
+		DA_IFUNLIKELY(n >= size()) {
+			DA_THROW(std::out_of_range(fmt::format("{}: n (which is {}) >= this->size() (which is {})", what, n, size())));
+		}
+	}
+
+	DA_CONSTEXPR size_type _M_offset(const_iterator pos) const noexcept {
+		DA_ASSERT(pos >= m_impl.m_begin && pos <= m_impl.m_end);
+		return static_cast<size_type>(pos - m_impl.m_begin);
+	}
+
+	/// The capacity after appending n more elements, grow by at least double
+	size_type _M_next_capacity(size_type n) const {
+		const size_type s = size();
+		DA_IFUNLIKELY(max_size() - s < n) {
+			DA_THROW(std::length_error(fmt::format("da::vector::_M_next_capacity: The new size (which is {} + {}) > max_size() (which is {})", s, n, max_size())));
+		}
+		const size_type c = s + std::max(s, n);
+		return (c < s || c > max_size()) ? max_size() : c;
+	}
+
+	/**
+	 * @brief Allocate for @param n elements and construct them by @param construct, only called by constructors
+	 * @note  The memory is freed if constructing throws, since the destructor is not called then
+	 */
+	template<typename F>
+	void _M_init(size_type n, F&& construct) {
+		DA_IFUNLIKELY(n > max_size()) {
+			DA_THROW(std::length_error(fmt::format("da::vector::vector: n (which is {}) > max_size() (which is {})", n, max_size())));
+		}
+		if(n > N) {
+			m_impl.m_begin = alloc_traits::allocate(_M_get_alloc(), n);
+			m_impl.m_end   = m_impl.m_begin;
+			m_impl.m_cap   = m_impl.m_begin + n;
+		}
+		DA_TRY {
+			m_impl.m_end = construct(m_impl.m_begin);
+		}
+		DA_CATCH(...) {
+			_M_deallocate(m_impl.m_begin, capacity());
+			DA_THROW_AGAIN();
+		}
+	}
+
+	/// Use the inline elements if there are enough, only when they are not in use, so that growing from them goes to the heap
+	pointer _M_allocate(size_type c) {
+		if constexpr(N != 0) {
+			if(c <= N && !m_impl._M_is_inline(m_impl.m_begin)) {
+				return m_impl._M_inline();
+			}
+		}
+		return alloc_traits::allocate(_M_get_alloc(), c);
+	}
+
+	void _M_deallocate(pointer p, size_type c) noexcept {
+		if(p != nullptr && !m_impl._M_is_inline(p)) {
+			alloc_traits::deallocate(_M_get_alloc(), p, c);
+		}
+	}
+
+	/// Destroy all elements and free the memory
+	void _M_release() noexcept {
+		std::destroy(m_impl.m_begin, m_impl.m_end);
+		_M_deallocate(m_impl.m_begin, capacity());
+		m_impl._M_reset();
+	}
+
+	/// Take the elements of @param v, only called on an empty vector with no memory allocated
+	void _M_steal(Self& v) noexcept(nothrow_steal) {
+		if(v.m_impl._M_is_inline(v.m_impl.m_begin)) { // Only the elements can be moved
+			m_impl.m_end   = uninitialized_relocate_n(v.m_impl.m_begin, v.size(), m_impl.m_begin);
+			v.m_impl.m_end = v.m_impl.m_begin;
+			return;
+		}
+		m_impl.m_begin = v.m_impl.m_begin;
+		m_impl.m_end   = v.m_impl.m_end;
+		m_impl.m_cap   = v.m_impl.m_cap;
+		v.m_impl._M_reset();
+	}
+
+	void _M_erase_at_end(pointer p) noexcept {
+		std::destroy(p, m_impl.m_end);
+		m_impl.m_end = p;
+	}
+
+	/**
+	 * @brief Move the elements to a new buffer of @param c elements,
+	 *        leaving a gap of @param n elements at @param off, which is filled by @param construct
+	 * @note  The new elements are constructed before the old ones are moved, so they may refer to the old elements
+	 * @note  @param c may fit in the inline elements only if they are not in use, the capacity is N then
+	 * @note  Strong exception guarantee, unless T is neither trivially relocatable
+	 *        nor copyable and its move constructor throws
+	 */
+	template<typename Construct>
+	void _M_reallocate(size_type c, size_type off, size_type n, Construct&& construct) {
+		const size_type s = size();
+		pointer const   p = _M_allocate(c);
+		DA_TRY {
+			construct(p + off);
+		}
+		DA_CATCH(...) {
+			_M_deallocate(p, c);
+			DA_THROW_AGAIN();
+		}
+		if constexpr(relocatable || std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+			uninitialized_relocate_n(m_impl.m_begin, off, p); // A single memcpy for relocatable types
+			uninitialized_relocate_n(m_impl.m_begin + off, s - off, p + off + n);
+		} else { // Copy to keep the old elements on exception
+			DA_TRY {
+				std::uninitialized_copy(m_impl.m_begin, m_impl.m_begin + off, p);
+				DA_TRY {
+					std::uninitialized_copy(m_impl.m_begin + off, m_impl.m_end, p + off + n);
+				}
+				DA_CATCH(...) {
+					std::destroy_n(p, off);
+					DA_THROW_AGAIN();
+				}
+			}
+			DA_CATCH(...) {
+				std::destroy_n(p + off, n);
+				_M_deallocate(p, c);
+				DA_THROW_AGAIN();
+			}
+			std::destroy(m_impl.m_begin, m_impl.m_end);
+		}
+		_M_deallocate(m_impl.m_begin, capacity());
+		m_impl.m_begin = p;
+		m_impl.m_end   = p + s + n;
+		m_impl.m_cap   = m_impl._M_is_inline(p) ? p + N : p + c;
+	}
+
+	/**
+	 * @brief Open a gap of @param n elements at @param off without reallocation,
+	 *        then fill it by @param construct
+	 */
+	template<typename Construct>
+	void _M_insert_in_place(size_type off, size_type n, Construct&& construct) {
+		DA_ASSERT(n <= capacity() - size());
+		pointer const   p    = m_impl.m_begin + off;
+		const size_type tail = size() - off;
+		if constexpr(relocatable) {
+			uninitialized_relocate_n(p, tail, p + n);
+			DA_TRY {
+				construct(p);
+			}
+			DA_CATCH(...) {
+				uninitialized_relocate_n(p + n, tail, p);
+				DA_THROW_AGAIN();
+			}
+			m_impl.m_end += n;
+		} else {
+			construct(m_impl.m_end);
+			m_impl.m_end += n;
+			std::rotate(p, m_impl.m_end - n, m_impl.m_end);
+		}
+	}
+
+	storage_type m_impl;
+};
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A std::vector-like container
+ * @note  Elements which are trivially relocatable (e.g. da::string) are moved by memcpy/memmove
+ *        on reallocation, insertion and erasure, instead of being move-constructed and destroyed one by one
+ * @note  Only allocators using raw pointers are supported
+ */
+template<typename T, typename Alloc = std::allocator<T>>
+class vector : public _DA_DETAIL basic_vector<T, Alloc, 0> {
+	public:
+	using _DA_DETAIL basic_vector<T, Alloc, 0>::basic_vector;
+	using _DA_DETAIL basic_vector<T, Alloc, 0>::operator=;
+};
+
+/// Erase all elements equal to @param v, return the number erased
+template<typename T, typename Alloc, size_t N, typename U>
+typename _DA_DETAIL basic_vector<T, Alloc, N>::size_type erase(_DA_DETAIL basic_vector<T, Alloc, N>& c, const U& v) {
+	auto it = std::remove(c.begin(), c.end(), v);
+	auto n  = static_cast<typename _DA_DETAIL basic_vector<T, Alloc, N>::size_type>(c.end() - it);
+	c.erase(it, c.end());
+	return n;
+}
+
+template<typename T, typename Alloc, size_t N, typename Pred>
+typename _DA_DETAIL basic_vector<T, Alloc, N>::size_type erase_if(_DA_DETAIL basic_vector<T, Alloc, N>& c, Pred pred) {
+	auto it = std::remove_if(c.begin(), c.end(), pred);
+	auto n  = static_cast<typename _DA_DETAIL basic_vector<T, Alloc, N>::size_type>(c.end() - it);
+	c.erase(it, c.end());
+	return n;
+}
+
+template<typename T, typename Alloc>
+struct is_trivially_relocatable<vector<T, Alloc>> : is_trivially_relocatable<Alloc> { };
+
+DA_END_NAMESPACE
+
+#endif // _DA_CONTAINER_VECTOR_HPP_
@@ -13,5 +13,14 @@
 
 #include <da/config.hpp>
 #include <da/memory/aligned_buffer.hpp>
+#include <da/memory/arena.hpp>
+#include <da/memory/cache_aligned.hpp>
+#include <da/memory/mapped_file.hpp>
+#include <da/memory/object_pool.hpp>
+#include <da/memory/page_allocator.hpp>
+#include <da/memory/pool_allocator.hpp>
+#include <da/memory/relocate.hpp>
+#include <da/memory/stack_allocator.hpp>
+#include <da/memory/tracking_allocator.hpp>
 
 #endif // _DA_MEMORY_HPP_
@@ -31,10 +31,10 @@ struct aligned_buffer {
 		return static_cast<const void*>(&m_storage);
 	}
 	inline T* ptr() noexcept {
-		return static_cast<T*>(&m_storage);
+		return static_cast<T*>(addr());
 	}
 	inline const T* ptr() const noexcept {
-		return static_cast<const T*>(&m_storage);
+		return static_cast<const T*>(addr());
 	}
 };
 
@@ -0,0 +1,215 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      arena.hpp
+ * @brief     A monotonic arena & its allocator
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_ARENA_HPP_
+#define _DA_MEMORY_ARENA_HPP_
+
+#include <da/config.hpp>
+#include <algorithm>
+#include <bit>     // for std::has_single_bit()
+#include <cstddef> // for std::max_align_t
+#include <cstdint> // for uintptr_t
+#include <limits>
+#include <memory>  // for std::construct_at()
+#include <new>
+#include <utility> // for std::exchange()
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A bump allocator over a chain of blocks, freeing everything at once by reset() or release()
+ * @note  Allocation only moves a pointer forward, and deallocate() only reclaims the last allocation
+ * @note  An optional initial buffer, e.g. on the stack, is used before any block is allocated.
+ *        It is not owned by the arena
+ * @note  Each new block is twice as large as the previous one, up to max_block_size
+ * @note  Not thread-safe
+ */
+class arena {
+	struct alignas(std::max_align_t) block_header {
+		block_header* next;
+		size_t        size; // Including the header
+	};
+
+	char*         m_cur          = nullptr;
+	char*         m_end          = nullptr;
+	block_header* m_blocks       = nullptr; // The blocks in use, the newest first
+	block_header* m_spare        = nullptr; // The block kept by reset(), only when m_blocks is empty
+	char*         m_initial      = nullptr;
+	size_t        m_initial_size = 0;
+	size_t        m_next_size;
+
+	public:
+	static inline constexpr size_t default_block_size = 4096;
+	static inline constexpr size_t max_block_size     = size_t(1) << 26; // Larger allocations still get their own block
+
+	public: // Constructors
+	arena() noexcept
+		: arena(default_block_size) { }
+
+	/// @param block_size The size of the first block allocated
+	explicit arena(size_t block_size) noexcept
+		: m_next_size(std::clamp(block_size, sizeof(block_header), max_block_size)) { }
+
+	/// Allocate from [@param buffer, buffer + size) first
+	arena(void* buffer, size_t size, size_t block_size = default_block_size) noexcept
+		: m_cur(static_cast<char*>(buffer))
+		, m_end(m_cur + size)
+		, m_initial(m_cur)
+		, m_initial_size(size)
+		, m_next_size(std::clamp(block_size, sizeof(block_header), max_block_size)) { }
+
+	arena(const arena&)            = delete;
+	arena& operator=(const arena&) = delete;
+
+	~arena() {
+		release();
+	}
+
+	public: // Allocation
+	/**
+	 * @brief  Allocate @param n bytes aligned to @param align, which must be a power of 2
+	 * @throw  std::bad_alloc if a new block cannot be allocated
+	 */
+	[[nodiscard]] void* allocate(size_t n, size_t align = alignof(std::max_align_t)) {
+		DA_ASSERT(std::has_single_bit(align));
+		const uintptr_t p   = (reinterpret_cast<uintptr_t>(m_cur) + align - 1) & ~(align - 1);
+		const uintptr_t end = reinterpret_cast<uintptr_t>(m_end);
+		DA_IFLIKELY(p <= end && end - p >= n) {
+			m_cur = reinterpret_cast<char*>(p + n);
+			return reinterpret_cast<void*>(p);
+		}
+		return _M_allocate_block(n, align);
+	}
+
+	/// Only reclaim the memory if it is the last allocation, otherwise it is kept until reset()
+	void deallocate(void* p, size_t n) noexcept {
+		if(static_cast<char*>(p) + n == m_cur) {
+			m_cur = static_cast<char*>(p);
+		}
+	}
+
+	/**
+	 * @brief Construct a T in the arena
+	 * @note  The destructor is never called by the arena, so it should be trivial or called manually
+	 */
+	template<typename T, typename... Args>
+	[[nodiscard]] T* create(Args&&... args) {
+		return std::construct_at(static_cast<T*>(allocate(sizeof(T), alignof(T))), std::forward<Args>(args)...);
+	}
+
+	/**
+	 * @brief Free all allocations, but keep the newest block for reuse
+	 * @note  The initial buffer is used first again
+	 */
+	void reset() noexcept {
+		if(m_blocks != nullptr) {
+			_S_free(m_blocks->next);
+			_S_free(m_spare);
+			m_spare       = m_blocks;
+			m_spare->next = nullptr;
+			m_blocks      = nullptr;
+		}
+		m_cur = m_initial;
+		m_end = m_initial + m_initial_size;
+	}
+
+	/// Free all allocations & all blocks
+	void release() noexcept {
+		_S_free(m_blocks);
+		_S_free(m_spare);
+		m_blocks = nullptr;
+		m_spare  = nullptr;
+		m_cur    = m_initial;
+		m_end    = m_initial + m_initial_size;
+	}
+
+	private: // Internal functions
+	void* _M_allocate_block(size_t n, size_t align) {
+		// No object is larger than PTRDIFF_MAX
+		DA_IFUNLIKELY(n > static_cast<size_t>(std::numeric_limits<ptrdiff_t>::max()) - align - sizeof(block_header)) {
+			DA_THROW(std::bad_alloc());
+		}
+		const size_t  need = n + align + sizeof(block_header);
+		block_header* b    = std::exchange(m_spare, nullptr);
+		if(b == nullptr || b->size < need) {
+			_S_free(b);
+			const size_t size = std::max(m_next_size, need);
+			b                 = static_cast<block_header*>(::operator new(size));
+			b->size           = size;
+			m_next_size       = std::min(m_next_size * 2, max_block_size);
+		}
+		b->next  = m_blocks;
+		m_blocks = b;
+		// The header is aligned to max_align_t, so there are at most align - 1 bytes of padding
+		char* const p = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(b + 1) + align - 1) & ~(align - 1));
+		m_cur         = p + n;
+		m_end         = reinterpret_cast<char*>(b) + b->size;
+		return p;
+	}
+
+	static void _S_free(block_header* b) noexcept {
+		while(b != nullptr) {
+			block_header* const next = b->next;
+			::operator delete(static_cast<void*>(b), b->size);
+			b = next;
+		}
+	}
+};
+
+/**
+ * @brief An allocator allocating from a da::arena, which must outlive all allocations
+ * @note  Like std::pmr::polymorphic_allocator, it is not propagated on assignment or swap,
+ *        and two allocators are equal if they use the same arena
+ */
+template<typename T>
+class arena_allocator {
+	template<typename U>
+	friend class arena_allocator;
+
+	arena* m_arena;
+
+	public:
+	typedef T         value_type;
+	typedef size_t    size_type;
+	typedef ptrdiff_t difference_type;
+
+	public: // Constructors
+	arena_allocator(arena& a) noexcept
+		: m_arena(&a) { }
+
+	template<typename U>
+	arena_allocator(const arena_allocator<U>& a) noexcept
+		: m_arena(a.m_arena) { }
+
+	public: // Allocation
+	[[nodiscard]] T* allocate(size_type n) {
+		DA_IFUNLIKELY(n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+			DA_THROW(std::bad_array_new_length());
+		}
+		return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, size_type n) noexcept {
+		m_arena->deallocate(p, n * sizeof(T));
+	}
+
+	arena& resource() const noexcept {
+		return *m_arena;
+	}
+
+	template<typename U>
+	friend bool operator==(const arena_allocator& a, const arena_allocator<U>& b) noexcept {
+		return &a.resource() == &b.resource();
+	}
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_MEMORY_ARENA_HPP_
@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      cache_aligned.hpp
+ * @brief     A value padded to occupy its own cache lines
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_CACHE_ALIGNED_HPP_
+#define _DA_MEMORY_CACHE_ALIGNED_HPP_
+
+#include <da/config.hpp>
+#include <utility>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief The minimum distance between two objects to avoid false sharing
+ * @note  The same as std::hardware_destructive_interference_size, which is not stable across compiler flags.
+ *        It is 128 on x86-64 & AArch64 since the adjacent cache lines are prefetched in pairs by many CPUs
+ */
+#if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64)
+inline constexpr size_t destructive_interference_size = 128;
+#else
+inline constexpr size_t destructive_interference_size = 64;
+#endif
+
+/**
+ * @brief A @tparam T aligned & padded to destructive_interference_size,
+ *        so that it never shares a cache line with another object, e.g. in an array of per-thread values
+ */
+template<typename T>
+struct alignas(destructive_interference_size) cache_aligned {
+	T value;
+
+	constexpr cache_aligned() = default;
+
+	template<typename... Args>
+	constexpr explicit cache_aligned(std::in_place_t, Args&&... args)
+		: value(std::forward<Args>(args)...) { }
+
+	constexpr T& operator*() noexcept {
+		return value;
+	}
+
+	constexpr const T& operator*() const noexcept {
+		return value;
+	}
+
+	constexpr T* operator->() noexcept {
+		return &value;
+	}
+
+	constexpr const T* operator->() const noexcept {
+		return &value;
+	}
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_MEMORY_CACHE_ALIGNED_HPP_
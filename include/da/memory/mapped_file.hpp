@@ -0,0 +1,275 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      mapped_file.hpp
+ * @brief     A file mapped into memory
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_MAPPED_FILE_HPP_
+#define _DA_MEMORY_MAPPED_FILE_HPP_
+
+#include <da/config.hpp>
+
+#if DA_UNIX // Only POSIX mmap is supported now
+
+	#include <da/format.hpp>
+	#include <da/preprocessor/enum.hpp>
+	#include <cerrno>
+	#include <cstddef> // for std::byte
+	#include <filesystem>
+	#include <span>
+	#include <system_error>
+	#include <type_traits>
+	#include <utility>
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A file mapped into memory, either read-only or read-write
+ * @note  A read-only mapping is private & the file is closed once mapped,
+ *        a read-write mapping is shared, i.e. writes go to the file, and keeps the file open for resize()
+ * @note  The mapping of an empty file is empty, with data() == nullptr
+ */
+class mapped_file {
+	public:
+	/// Hints passed to madvise()
+	DA_DEFINE_SCOPED_MASK_ENUM(access_hint, sequential, random, willneed, dontneed);
+	DA_DEFINE_ENUM_OPS(access_hint, friend DA_CONSTEXPR);
+
+	/// Read-only & lazily loaded without any of them
+	DA_DEFINE_SCOPED_MASK_ENUM(open_mode, read_write, populate);
+	DA_DEFINE_ENUM_OPS(open_mode, friend DA_CONSTEXPR);
+
+	public: // Constructors
+	mapped_file() noexcept = default;
+
+	mapped_file(const mapped_file&)            = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+
+	mapped_file(mapped_file&& f) noexcept
+		: m_data(std::exchange(f.m_data, nullptr))
+		, m_size(std::exchange(f.m_size, 0))
+		, m_fd(std::exchange(f.m_fd, -1))
+		, m_open(std::exchange(f.m_open, false)) { }
+
+	mapped_file& operator=(mapped_file&& f) noexcept {
+		if(this != &f) {
+			close();
+			m_data = std::exchange(f.m_data, nullptr);
+			m_size = std::exchange(f.m_size, 0);
+			m_fd   = std::exchange(f.m_fd, -1);
+			m_open = std::exchange(f.m_open, false);
+		}
+		return *this;
+	}
+
+	~mapped_file() {
+		close();
+	}
+
+	/**
+	 * @brief  Map the whole file at @param path
+	 * @param  mode open_mode::read_write creates the file if not exist,
+	 *         open_mode::populate loads the whole file at once (MAP_POPULATE)
+	 * @throw  std::system_error if the file cannot be opened or mapped
+	 */
+	[[nodiscard]] static mapped_file open(const std::filesystem::path& path, open_mode mode = open_mode{}) {
+		const bool writable = bool(mode & open_mode::read_write);
+		const int  fd       = writable ? ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644) : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		DA_IFUNLIKELY(fd < 0) {
+			DA_THROW(std::system_error(errno, std::generic_category(), fmt::format("da::mapped_file::open: Cannot open {}", path.string())));
+		}
+		mapped_file ret;
+		ret.m_fd   = fd; // Closed by ret on exception
+		ret.m_open = true;
+		struct stat st;
+		DA_IFUNLIKELY(::fstat(fd, &st) != 0) {
+			DA_THROW(std::system_error(errno, std::generic_category(), fmt::format("da::mapped_file::open: Cannot stat {}", path.string())));
+		}
+		if(st.st_size > 0) { // Mapping an empty file fails
+			ret._M_map(static_cast<size_t>(st.st_size), writable, bool(mode & open_mode::populate));
+		}
+		if(!writable) {
+			::close(std::exchange(ret.m_fd, -1)); // The mapping keeps the file alive
+		}
+		return ret;
+	}
+
+	/// Unmap the file, it becomes empty
+	void close() noexcept {
+		if(m_data != nullptr) {
+			::munmap(m_data, m_size);
+			m_data = nullptr;
+			m_size = 0;
+		}
+		if(m_fd >= 0) {
+			::close(std::exchange(m_fd, -1));
+		}
+		m_open = false;
+	}
+
+	public: // Observers
+	/// True since open() until close(), even for an empty file
+	bool is_open() const noexcept {
+		return m_open;
+	}
+
+	bool writable() const noexcept {
+		return m_fd >= 0;
+	}
+
+	DA_CONSTEXPR std::byte* data() noexcept {
+		return m_data;
+	}
+
+	DA_CONSTEXPR const std::byte* data() const noexcept {
+		return m_data;
+	}
+
+	/// In bytes
+	DA_CONSTEXPR size_t size() const noexcept {
+		return m_size;
+	}
+
+	DA_CONSTEXPR bool empty() const noexcept {
+		return m_size == 0;
+	}
+
+	/**
+	 * @brief View the content as an array of T without copying, a trailing partial T is ignored
+	 * @note  The mapping is page-aligned, so T is aligned if the file is laid out properly
+	 */
+	template<typename T>
+	std::span<const T> as_span() const noexcept {
+		static_assert(std::is_trivially_copyable_v<T>, "da::mapped_file::as_span: T must be trivially copyable");
+		return {reinterpret_cast<const T*>(m_data), m_size / sizeof(T)};
+	}
+
+	/// The same as as_span(), but the content can be written, only for read-write mappings
+	template<typename T>
+	std::span<T> as_writable_span() noexcept {
+		static_assert(std::is_trivially_copyable_v<T>, "da::mapped_file::as_writable_span: T must be trivially copyable");
+		DA_ASSERT(writable());
+		return {reinterpret_cast<T*>(m_data), m_size / sizeof(T)};
+	}
+
+	public: // Operations
+	/// Change the expected access pattern, failures are ignored since they are only hints
+	void advise(access_hint hint) const noexcept {
+		if(m_data == nullptr) {
+			return;
+		}
+		if(bool(hint & access_hint::sequential)) {
+			::madvise(m_data, m_size, MADV_SEQUENTIAL);
+		}
+		if(bool(hint & access_hint::random)) {
+			::madvise(m_data, m_size, MADV_RANDOM);
+		}
+		if(bool(hint & access_hint::willneed)) {
+			::madvise(m_data, m_size, MADV_WILLNEED);
+		}
+		if(bool(hint & access_hint::dontneed)) {
+			::madvise(m_data, m_size, MADV_DONTNEED);
+		}
+	}
+
+	/**
+	 * @brief Change the size of the file & the mapping to @param n bytes, only for read-write mappings
+	 * @throw std::system_error if the file cannot be resized or mapped, the file is restored then
+	 * @note  The mapping may be moved, the new bytes are zeros
+	 */
+	void resize(size_t n) {
+		DA_ASSERT(writable());
+		if(n == m_size) {
+			return;
+		}
+		DA_IFUNLIKELY(::ftruncate(m_fd, static_cast<off_t>(n)) != 0) {
+			DA_THROW(std::system_error(errno, std::generic_category(), "da::mapped_file::resize: Cannot resize the file"));
+		}
+		if(n == 0) {
+			::munmap(m_data, m_size);
+			m_data = nullptr;
+			m_size = 0;
+			return;
+		}
+		DA_TRY {
+			if(m_data == nullptr) {
+				_M_map(n, true, false);
+			} else {
+	#if DA_LINUX
+				void* const p = ::mremap(m_data, m_size, n, MREMAP_MAYMOVE);
+	#else
+				void* const p = ::mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+	#endif
+				DA_IFUNLIKELY(p == MAP_FAILED) {
+					DA_THROW(std::system_error(errno, std::generic_category(), "da::mapped_file::resize: Cannot remap the file"));
+				}
+	#if !DA_LINUX
+				::munmap(m_data, m_size);
+	#endif
+				m_data = static_cast<std::byte*>(p);
+				m_size = n;
+			}
+		}
+		DA_CATCH(...) {
+			(void)::ftruncate(m_fd, static_cast<off_t>(m_size));
+			DA_THROW_AGAIN();
+		}
+	}
+
+	/// Write the changes back to the file synchronously
+	void sync() const {
+		DA_IFUNLIKELY(m_data != nullptr && ::msync(m_data, m_size, MS_SYNC) != 0) {
+			DA_THROW(std::system_error(errno, std::generic_category(), "da::mapped_file::sync: Cannot sync the file"));
+		}
+	}
+
+	void swap(mapped_file& f) noexcept {
+		std::swap(m_data, f.m_data);
+		std::swap(m_size, f.m_size);
+		std::swap(m_fd, f.m_fd);
+		std::swap(m_open, f.m_open);
+	}
+
+	friend void swap(mapped_file& a, mapped_file& b) noexcept {
+		a.swap(b);
+	}
+
+	private: // Internal functions
+	void _M_map(size_t n, bool writable, bool populate) {
+		int flags = writable ? MAP_SHARED : MAP_PRIVATE;
+	#ifdef MAP_POPULATE
+		if(populate) {
+			flags |= MAP_POPULATE;
+			populate = false;
+		}
+	#endif
+		void* const p = ::mmap(nullptr, n, writable ? PROT_READ | PROT_WRITE : PROT_READ, flags, m_fd, 0);
+		DA_IFUNLIKELY(p == MAP_FAILED) {
+			DA_THROW(std::system_error(errno, std::generic_category(), "da::mapped_file::open: Cannot map the file"));
+		}
+		m_data = static_cast<std::byte*>(p);
+		m_size = n;
+		if(populate) { // No MAP_POPULATE
+			advise(access_hint::willneed);
+		}
+	}
+
+	std::byte* m_data = nullptr;
+	size_t     m_size = 0;
+	int        m_fd   = -1; // Only kept open by read-write mappings
+	bool       m_open = false;
+};
+
+DA_END_NAMESPACE
+
+#endif // DA_UNIX
+
+#endif // _DA_MEMORY_MAPPED_FILE_HPP_
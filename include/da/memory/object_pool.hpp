@@ -0,0 +1,230 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      object_pool.hpp
+ * @brief     A pool of fixed-size slots for objects created & destroyed frequently
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_OBJECT_POOL_HPP_
+#define _DA_MEMORY_OBJECT_POOL_HPP_
+
+#include <da/config.hpp>
+#include <da/memory/aligned_buffer.hpp>
+#include <algorithm>
+#include <memory>  // for std::construct_at(), std::unique_ptr
+#include <mutex>   // for std::lock_guard
+#include <utility> // for std::exchange()
+#include <vector>
+
+DA_BEGIN_NAMESPACE
+
+/// A mutex doing nothing, for the pools used by a single thread
+struct null_mutex {
+	void lock() noexcept { }
+	void unlock() noexcept { }
+	bool try_lock() noexcept {
+		return true;
+	}
+};
+
+/**
+ * @brief  A pool of aligned_buffer<T> slots, with a free list threaded through the free slots
+ * @tparam Mutex Guards the pool, e.g. std::mutex when shared by threads, null_mutex by default
+ * @note   Slots are allocated in chunks, each twice as large as the previous one up to max_chunk_size slots,
+ *         and carved lazily, so that a new chunk is not touched until used
+ * @note   The memory is only returned to the system when the pool is destroyed,
+ *         all objects must be destroyed before that
+ * @note   Threads sharing a pool should each use a local_cache, which only locks once for a batch of slots
+ */
+template<typename T, typename Mutex = null_mutex>
+class object_pool {
+	union slot {
+		slot*             next;
+		aligned_buffer<T> storage;
+	};
+
+	public:
+	typedef T      value_type;
+	typedef size_t size_type;
+
+	static inline constexpr size_type min_chunk_size = 32;
+	static inline constexpr size_type max_chunk_size = 4096;
+
+	class local_cache;
+
+	public: // Constructors
+	object_pool() = default;
+
+	object_pool(const object_pool&)            = delete;
+	object_pool& operator=(const object_pool&) = delete;
+
+	public: // Allocation
+	/**
+	 * @brief Construct a T in a free slot
+	 * @note  The slot is returned to the pool if the constructor throws
+	 */
+	template<typename... Args>
+	[[nodiscard]] T* construct(Args&&... args) {
+		slot* const s = _M_acquire();
+		DA_TRY {
+			return std::construct_at(s->storage.ptr(), std::forward<Args>(args)...);
+		}
+		DA_CATCH(...) {
+			_M_release(s, s);
+			DA_THROW_AGAIN();
+		}
+	}
+
+	/// Destroy @param p constructed by this pool and return its slot, nullptr is ignored
+	void destroy(T* p) noexcept {
+		DA_IFLIKELY(p != nullptr) {
+			std::destroy_at(p);
+			slot* const s = _S_slot_of(p);
+			_M_release(s, s);
+		}
+	}
+
+	/// The number of slots allocated, either used or free
+	[[nodiscard]] size_type capacity() const noexcept {
+		std::lock_guard lock(m_mutex);
+		return m_capacity;
+	}
+
+	private: // Internal functions
+	static slot* _S_slot_of(T* p) noexcept {
+		return reinterpret_cast<slot*>(p); // The storage is at the beginning of the slot
+	}
+
+	slot* _M_acquire() {
+		std::lock_guard lock(m_mutex);
+		return _M_acquire_unlocked();
+	}
+
+	/// Take up to @param n slots as a list, at least one slot is taken
+	slot* _M_acquire(size_type n, size_type& taken) {
+		std::lock_guard lock(m_mutex);
+		slot* head = nullptr;
+		for(taken = 0; taken < n && (taken == 0 || m_free != nullptr || m_cur != m_end); ++taken) {
+			slot* const s = _M_acquire_unlocked();
+			s->next       = head;
+			head          = s;
+		}
+		return head;
+	}
+
+	slot* _M_acquire_unlocked() {
+		DA_IFLIKELY(m_free != nullptr) {
+			slot* const s = m_free;
+			m_free        = s->next;
+			return s;
+		}
+		DA_IFUNLIKELY(m_cur == m_end) {
+			m_chunks.emplace_back(new slot[m_chunk_size]);
+			m_cur = m_chunks.back().get();
+			m_end = m_cur + m_chunk_size;
+			m_capacity += m_chunk_size;
+			m_chunk_size = std::min(m_chunk_size * 2, max_chunk_size);
+		}
+		return m_cur++;
+	}
+
+	/// Return the list [@param head, tail] to the free list
+	void _M_release(slot* head, slot* tail) noexcept {
+		std::lock_guard lock(m_mutex);
+		tail->next = m_free;
+		m_free     = head;
+	}
+
+	mutable Mutex                        m_mutex;
+	slot*                                m_free       = nullptr;
+	slot*                                m_cur        = nullptr; // The uncarved slots of the newest chunk
+	slot*                                m_end        = nullptr;
+	size_type                            m_capacity   = 0;
+	size_type                            m_chunk_size = min_chunk_size;
+	std::vector<std::unique_ptr<slot[]>> m_chunks;
+};
+
+/**
+ * @brief A cache of free slots used by a single thread, which exchanges batch_size slots with the pool at a time
+ * @note  Usually declared thread_local, and it must be destroyed before the pool.
+ *        Objects may be destroyed by any cache of the same pool or the pool itself
+ */
+template<typename T, typename Mutex>
+class object_pool<T, Mutex>::local_cache {
+	public:
+	static inline constexpr size_type batch_size = 32;
+
+	explicit local_cache(object_pool& pool) noexcept
+		: m_pool(&pool) { }
+
+	local_cache(const local_cache&)            = delete;
+	local_cache& operator=(const local_cache&) = delete;
+
+	~local_cache() {
+		flush();
+	}
+
+	template<typename... Args>
+	[[nodiscard]] T* construct(Args&&... args) {
+		DA_IFUNLIKELY(m_free == nullptr) {
+			m_free = m_pool->_M_acquire(batch_size, m_count);
+		}
+		slot* const s = m_free;
+		m_free        = s->next;
+		--m_count;
+		DA_TRY {
+			return std::construct_at(s->storage.ptr(), std::forward<Args>(args)...);
+		}
+		DA_CATCH(...) {
+			_M_push(s);
+			DA_THROW_AGAIN();
+		}
+	}
+
+	void destroy(T* p) noexcept {
+		DA_IFLIKELY(p != nullptr) {
+			std::destroy_at(p);
+			_M_push(_S_slot_of(p));
+			DA_IFUNLIKELY(m_count >= 2 * batch_size) { // Keep half, so that alternating calls don't lock every time
+				slot* tail = m_free;
+				for(size_type i = 1; i < batch_size; ++i) {
+					tail = tail->next;
+				}
+				slot* const head = std::exchange(m_free, tail->next);
+				m_count -= batch_size;
+				m_pool->_M_release(head, tail);
+			}
+		}
+	}
+
+	/// Return all cached slots to the pool
+	void flush() noexcept {
+		if(m_free != nullptr) {
+			slot* tail = m_free;
+			while(tail->next != nullptr) {
+				tail = tail->next;
+			}
+			m_pool->_M_release(m_free, tail);
+			m_free  = nullptr;
+			m_count = 0;
+		}
+	}
+
+	private:
+	void _M_push(slot* s) noexcept {
+		s->next = m_free;
+		m_free  = s;
+		++m_count;
+	}
+
+	object_pool* m_pool;
+	slot*        m_free  = nullptr;
+	size_type    m_count = 0;
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_MEMORY_OBJECT_POOL_HPP_
@@ -0,0 +1,223 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      page_allocator.hpp
+ * @brief     Allocators mapping whole pages, optionally huge pages
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_PAGE_ALLOCATOR_HPP_
+#define _DA_MEMORY_PAGE_ALLOCATOR_HPP_
+
+#include <da/config.hpp>
+
+#if DA_UNIX // Only POSIX mmap is supported now
+
+	#include <cstdint> // for uintptr_t
+	#include <limits>
+	#include <new>
+	#include <type_traits>
+	#include <sys/mman.h>
+	#include <unistd.h>
+
+DA_BEGIN_NAMESPACE
+
+/// The size of a normal page
+[[nodiscard]] inline size_t page_size() noexcept {
+	static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+	return size;
+}
+
+/// The size of the huge pages used, 2 MiB on x86-64 & most AArch64 systems
+inline constexpr size_t huge_page_size = size_t(2) << 20;
+
+/// How the pages are mapped
+enum class page_kind {
+	normal,
+	transparent_huge, // Aligned to huge_page_size & advised by MADV_HUGEPAGE, the kernel may back it by huge pages
+	huge,             // Reserved huge pages by MAP_HUGETLB, falling back to transparent_huge if none is available
+};
+
+DA_END_NAMESPACE
+
+DA_BEGIN_DETAIL
+
+/// The length of the mapping for @param n bytes
+inline size_t page_mapping_size(size_t n, page_kind kind) noexcept {
+	const size_t align = kind == page_kind::normal ? page_size() : huge_page_size;
+	return (n + align - 1) & ~(align - 1);
+}
+
+inline void* map_anonymous(size_t n, int flags) noexcept {
+	void* const p = ::mmap(nullptr, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+	return p == MAP_FAILED ? nullptr : p;
+}
+
+/// Map @param size bytes aligned to huge_page_size, by mapping more & trimming both ends
+inline void* map_huge_aligned(size_t size) noexcept {
+	DA_IFUNLIKELY(size > std::numeric_limits<size_t>::max() - huge_page_size) {
+		return nullptr;
+	}
+	char* const p = static_cast<char*>(map_anonymous(size + huge_page_size, 0));
+	DA_IFUNLIKELY(p == nullptr) {
+		return nullptr;
+	}
+	char* const aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(p) + huge_page_size - 1) & ~(huge_page_size - 1));
+	if(aligned != p) {
+		::munmap(p, static_cast<size_t>(aligned - p));
+	}
+	if(const size_t tail = static_cast<size_t>(p + huge_page_size - aligned); tail != 0) {
+		::munmap(aligned + size, tail);
+	}
+	#ifdef MADV_HUGEPAGE
+	::madvise(aligned, size, MADV_HUGEPAGE); // Only a hint, e.g. fails if THP is disabled
+	#endif
+	return aligned;
+}
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief  Map at least @param n bytes of zeroed memory, aligned to the page size of @param kind
+ * @throw  std::bad_alloc if the memory cannot be mapped
+ * @note   page_kind::huge falls back to page_kind::transparent_huge silently, both are freed the same way
+ */
+[[nodiscard]] inline void* map_pages(size_t n, page_kind kind = page_kind::normal) {
+	DA_IFUNLIKELY(n == 0) {
+		n = 1;
+	}
+	const size_t size = _DA_DETAIL page_mapping_size(n, kind);
+	DA_IFUNLIKELY(size < n) {
+		DA_THROW(std::bad_alloc());
+	}
+	void* p = nullptr;
+	switch(kind) {
+	case page_kind::huge:
+	#ifdef MAP_HUGETLB
+		#ifdef MAP_HUGE_2MB
+		p = _DA_DETAIL map_anonymous(size, MAP_HUGETLB | MAP_HUGE_2MB);
+		#else
+		p = _DA_DETAIL map_anonymous(size, MAP_HUGETLB);
+		#endif
+		if(p != nullptr) {
+			break;
+		}
+	#endif
+		[[fallthrough]];
+	case page_kind::transparent_huge:
+		p = _DA_DETAIL map_huge_aligned(size);
+		break;
+	case page_kind::normal:
+		p = _DA_DETAIL map_anonymous(size, 0);
+		break;
+	}
+	DA_IFUNLIKELY(p == nullptr) {
+		DA_THROW(std::bad_alloc());
+	}
+	return p;
+}
+
+/// Unmap @param p returned by map_pages() with the same @param n & @param kind
+inline void unmap_pages(void* p, size_t n, page_kind kind = page_kind::normal) noexcept {
+	::munmap(p, _DA_DETAIL page_mapping_size(n == 0 ? 1 : n, kind));
+}
+
+/**
+ * @brief A stateless allocator mapping pages directly for each allocation
+ * @note  Meant for large buffers, since even a single byte takes a whole page & a system call
+ */
+template<typename T>
+class page_allocator {
+	public:
+	typedef T         value_type;
+	typedef size_t    size_type;
+	typedef ptrdiff_t difference_type;
+
+	public: // Constructors
+	constexpr page_allocator() noexcept = default;
+
+	template<typename U>
+	constexpr page_allocator(const page_allocator<U>&) noexcept { }
+
+	public: // Allocation
+	[[nodiscard]] T* allocate(size_type n) {
+		DA_IFUNLIKELY(n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+			DA_THROW(std::bad_array_new_length());
+		}
+		return static_cast<T*>(map_pages(n * sizeof(T)));
+	}
+
+	void deallocate(T* p, size_type n) noexcept {
+		unmap_pages(p, n * sizeof(T));
+	}
+
+	template<typename U>
+	friend constexpr bool operator==(const page_allocator&, const page_allocator<U>&) noexcept {
+		return true;
+	}
+};
+
+/**
+ * @brief An allocator mapping huge pages for allocations of at least huge_page_size bytes,
+ *        which reduces the TLB misses of random accesses to large buffers, e.g. indexes
+ * @note  Transparent huge pages are used by default, the reserved ones (MAP_HUGETLB) are used if requested
+ *        and available. Smaller allocations are mapped by normal pages
+ * @note  Any two of them are equal, since the memory is freed the same way
+ */
+template<typename T>
+class huge_page_allocator {
+	template<typename U>
+	friend class huge_page_allocator;
+
+	page_kind m_kind = page_kind::transparent_huge;
+
+	public:
+	typedef T              value_type;
+	typedef size_t         size_type;
+	typedef ptrdiff_t      difference_type;
+	typedef std::true_type is_always_equal;
+
+	public: // Constructors
+	constexpr huge_page_allocator() noexcept = default;
+
+	/// @param reserved Use the huge pages reserved by the system (e.g. by vm.nr_hugepages) first
+	constexpr explicit huge_page_allocator(bool reserved) noexcept
+		: m_kind(reserved ? page_kind::huge : page_kind::transparent_huge) { }
+
+	template<typename U>
+	constexpr huge_page_allocator(const huge_page_allocator<U>& a) noexcept
+		: m_kind(a.m_kind) { }
+
+	public: // Allocation
+	[[nodiscard]] T* allocate(size_type n) {
+		DA_IFUNLIKELY(n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+			DA_THROW(std::bad_array_new_length());
+		}
+		return static_cast<T*>(map_pages(n * sizeof(T), _S_kind(n * sizeof(T), m_kind)));
+	}
+
+	void deallocate(T* p, size_type n) noexcept {
+		// Both kinds of huge pages are unmapped the same way
+		unmap_pages(p, n * sizeof(T), _S_kind(n * sizeof(T), page_kind::transparent_huge));
+	}
+
+	template<typename U>
+	friend constexpr bool operator==(const huge_page_allocator&, const huge_page_allocator<U>&) noexcept {
+		return true;
+	}
+
+	private:
+	static constexpr page_kind _S_kind(size_t bytes, page_kind kind) noexcept {
+		return bytes < huge_page_size ? page_kind::normal : kind;
+	}
+};
+
+DA_END_NAMESPACE
+
+#endif // DA_UNIX
+
+#endif // _DA_MEMORY_PAGE_ALLOCATOR_HPP_
@@ -0,0 +1,254 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      pool_allocator.hpp
+ * @brief     A thread-caching allocator for small objects
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_POOL_ALLOCATOR_HPP_
+#define _DA_MEMORY_POOL_ALLOCATOR_HPP_
+
+#include <da/config.hpp>
+#include <cstddef> // for std::max_align_t
+#include <limits>
+#include <mutex>
+#include <new>
+
+DA_BEGIN_DETAIL
+
+/**
+ * @brief The size classes of pool_allocator, from 16 to max_size bytes in steps of 16,
+ *        so that every block is aligned to max_align_t & large enough for two links
+ */
+struct pool_size_class {
+	static inline constexpr size_t step       = 16;
+	static inline constexpr size_t max_size   = 256;
+	static inline constexpr size_t count      = max_size / step;
+	static inline constexpr size_t batch_size = 32;        // Blocks moved between a magazine & the depot at a time
+	static inline constexpr size_t chunk_size = 64 * 1024; // Bytes carved into blocks at a time
+
+	static_assert(alignof(std::max_align_t) <= step);
+
+	static constexpr size_t index(size_t n) noexcept {
+		return (n + step - 1) / step - (n != 0);
+	}
+
+	static constexpr size_t size(size_t c) noexcept {
+		return (c + 1) * step;
+	}
+};
+
+struct pool_block {
+	pool_block* next;       // The next block in the same magazine or batch
+	pool_block* batch_next; // Only used by the first block of a batch in the depot
+};
+
+/**
+ * @brief A stack of batches, each a list of blocks
+ * @note  It is guarded by a mutex, which is taken once per batch_size allocations or deallocations
+ *        of a thread at most. The links are only accessed under the mutex while the blocks are in the depot,
+ *        so they never race with the owner of a block popped by another thread
+ */
+class pool_depot {
+	std::mutex  m_mutex;
+	pool_block* m_head = nullptr;
+
+	public:
+	void push(pool_block* batch) noexcept {
+		std::lock_guard lock(m_mutex);
+		batch->batch_next = m_head;
+		m_head            = batch;
+	}
+
+	pool_block* pop() noexcept {
+		std::lock_guard   lock(m_mutex);
+		pool_block* const b = m_head;
+		if(b != nullptr) {
+			m_head = b->batch_next;
+		}
+		return b;
+	}
+};
+
+/// The blocks shared by all threads, the chunks are kept until the process exits
+struct pool_global {
+	struct size_class {
+		pool_depot depot;
+		std::mutex mutex; // Guards the carving below
+		char*      cur   = nullptr;
+		char*      end   = nullptr;
+		void*      chunk = nullptr; // Chunks are linked by their first word, only to keep them reachable
+	};
+
+	size_class classes[pool_size_class::count];
+
+	/// A new batch of @param n blocks of class @param c
+	pool_block* carve(size_t c, size_t n) {
+		const size_t    size = pool_size_class::size(c);
+		size_class&     s    = classes[c];
+		std::lock_guard lock(s.mutex);
+		pool_block*     head = nullptr;
+		for(size_t i = 0; i < n; ++i) {
+			DA_IFUNLIKELY(static_cast<size_t>(s.end - s.cur) < size) {
+				void* const chunk = ::operator new(pool_size_class::chunk_size);
+				*static_cast<void**>(chunk) = s.chunk;
+				s.chunk                     = chunk;
+				s.cur                       = static_cast<char*>(chunk) + pool_size_class::step;
+				s.end                       = static_cast<char*>(chunk) + pool_size_class::chunk_size;
+			}
+			pool_block* const b = reinterpret_cast<pool_block*>(s.cur);
+			s.cur += size;
+			b->next = head;
+			head    = b;
+		}
+		return head;
+	}
+};
+
+// Constant-initialized, so that threads exiting late can still return their blocks
+inline constinit pool_global pool_global_state{};
+
+/**
+ * @brief The magazines of a thread, each a list of free blocks of a class
+ * @note  A magazine is refilled by a batch from the depot when empty,
+ *        and gives a batch back when it holds 2 * batch_size blocks
+ */
+class pool_thread_cache {
+	struct magazine {
+		pool_block* head  = nullptr;
+		size_t      count = 0;
+	};
+
+	magazine m_magazines[pool_size_class::count];
+
+	public:
+	constexpr pool_thread_cache() noexcept = default;
+
+	pool_thread_cache(const pool_thread_cache&)            = delete;
+	pool_thread_cache& operator=(const pool_thread_cache&) = delete;
+
+	~pool_thread_cache() {
+		for(magazine& m : m_magazines) {
+			if(m.head != nullptr) {
+				pool_global_state.classes[&m - m_magazines].depot.push(m.head);
+				m = {}; // In case of being used by the destructors of other thread-local objects
+			}
+		}
+	}
+
+	void* allocate(size_t c) {
+		magazine& m = m_magazines[c];
+		DA_IFUNLIKELY(m.head == nullptr) {
+			_M_refill(c, m);
+		}
+		pool_block* const b = m.head;
+		m.head              = b->next;
+		--m.count;
+		return b;
+	}
+
+	void deallocate(void* p, size_t c) noexcept {
+		magazine&         m = m_magazines[c];
+		pool_block* const b = static_cast<pool_block*>(p);
+		b->next             = m.head;
+		m.head              = b;
+		DA_IFUNLIKELY(++m.count >= 2 * pool_size_class::batch_size) {
+			pool_block* tail = b;
+			for(size_t i = 1; i < pool_size_class::batch_size; ++i) {
+				tail = tail->next;
+			}
+			m.head     = tail->next;
+			tail->next = nullptr;
+			m.count -= pool_size_class::batch_size;
+			pool_global_state.classes[c].depot.push(b);
+		}
+	}
+
+	private:
+	static void _M_refill(size_t c, magazine& m) {
+		pool_block* b = pool_global_state.classes[c].depot.pop();
+		if(b == nullptr) {
+			b = pool_global_state.carve(c, pool_size_class::batch_size);
+		}
+		m.head  = b;
+		m.count = 0;
+		for(; b != nullptr; b = b->next) { // The batches given back at thread exit may be partial
+			++m.count;
+		}
+	}
+};
+
+inline thread_local pool_thread_cache pool_local_cache;
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief Allocate @param n bytes aligned to @param align from the thread-local pools,
+ *        falling back to ::operator new for more than pool_size_class::max_size bytes or over-aligned memory
+ */
+[[nodiscard]] inline void* pool_allocate(size_t n, size_t align = alignof(std::max_align_t)) {
+	DA_IFLIKELY(n <= _DA_DETAIL pool_size_class::max_size && align <= alignof(std::max_align_t)) {
+		return _DA_DETAIL pool_local_cache.allocate(_DA_DETAIL pool_size_class::index(n));
+	}
+	return align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? ::operator new(n) : ::operator new(n, std::align_val_t(align));
+}
+
+/// Free @param p allocated by pool_allocate() with the same @param n & @param align, in any thread
+inline void pool_deallocate(void* p, size_t n, size_t align = alignof(std::max_align_t)) noexcept {
+	DA_IFLIKELY(n <= _DA_DETAIL pool_size_class::max_size && align <= alignof(std::max_align_t)) {
+		_DA_DETAIL pool_local_cache.deallocate(p, _DA_DETAIL pool_size_class::index(n));
+		return;
+	}
+	if(align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+		::operator delete(p, n);
+	} else {
+		::operator delete(p, n, std::align_val_t(align));
+	}
+}
+
+/**
+ * @brief A stateless allocator for small objects, e.g. the bodies of strings & the nodes of containers
+ * @note  Each thread allocates from its own magazines without any lock, and exchanges batches of blocks
+ *        with a depot shared by all threads. Memory freed by another thread simply goes to
+ *        the magazine of that thread, so no block is owned by a thread
+ * @note  The memory is kept for reuse until the process exits
+ */
+template<typename T>
+class pool_allocator {
+	public:
+	typedef T         value_type;
+	typedef size_t    size_type;
+	typedef ptrdiff_t difference_type;
+
+	public: // Constructors
+	constexpr pool_allocator() noexcept = default;
+
+	template<typename U>
+	constexpr pool_allocator(const pool_allocator<U>&) noexcept { }
+
+	public: // Allocation
+	[[nodiscard]] T* allocate(size_type n) {
+		DA_IFUNLIKELY(n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+			DA_THROW(std::bad_array_new_length());
+		}
+		return static_cast<T*>(pool_allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, size_type n) noexcept {
+		pool_deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	template<typename U>
+	friend constexpr bool operator==(const pool_allocator&, const pool_allocator<U>&) noexcept {
+		return true;
+	}
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_MEMORY_POOL_ALLOCATOR_HPP_
@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      relocate.hpp
+ * @brief     Move objects to uninitialized memory and destroy the origin
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_RELOCATE_HPP_
+#define _DA_MEMORY_RELOCATE_HPP_
+
+#include <da/config.hpp>
+#include <da/type_traits/relocatable.hpp>
+#include <cstring>
+#include <memory>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief  Move-construct [first, first + n) to the uninitialized memory at @param dest,
+ *         then destroy the origin objects
+ * @return The end of the relocated objects
+ * @note   Trivially relocatable types are moved by a single memmove, so the ranges may overlap,
+ *         for other types the ranges must not overlap
+ * @note   If a constructor throws, the objects already constructed at @param dest are destroyed
+ *         and the origin objects are untouched
+ */
+template<typename T>
+T* uninitialized_relocate_n(T* first, size_t n, T* dest) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+	if constexpr(is_trivially_relocatable_v<T>) {
+		DA_IFLIKELY(n != 0) {
+			std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+		}
+	} else {
+		DA_ASSERT(dest + n <= first || first + n <= dest);
+		if constexpr(std::is_nothrow_move_constructible_v<T>) {
+			for(size_t i = 0; i < n; ++i) {
+				std::construct_at(dest + i, std::move(first[i]));
+			}
+		} else {
+			size_t i = 0;
+			DA_TRY {
+				for(; i < n; ++i) {
+					std::construct_at(dest + i, std::move_if_noexcept(first[i]));
+				}
+			}
+			DA_CATCH(...) {
+				std::destroy_n(dest, i);
+				DA_THROW_AGAIN();
+			}
+		}
+		std::destroy_n(first, n);
+	}
+	return dest + n;
+}
+
+template<typename T>
+T* uninitialized_relocate(T* first, T* last, T* dest) noexcept(noexcept(uninitialized_relocate_n(first, 0, dest))) {
+	return uninitialized_relocate_n(first, static_cast<size_t>(last - first), dest);
+}
+
+/**
+ * @brief Relocate a single object from @param src to @param dest
+ */
+template<typename T>
+T* relocate_at(T* src, T* dest) noexcept(noexcept(uninitialized_relocate_n(src, 1, dest))) {
+	if constexpr(is_trivially_relocatable_v<T>) {
+		std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), sizeof(T));
+		return dest;
+	} else {
+		T* const p = std::construct_at(dest, std::move_if_noexcept(*src));
+		std::destroy_at(src);
+		return p;
+	}
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_MEMORY_RELOCATE_HPP_
@@ -0,0 +1,140 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      stack_allocator.hpp
+ * @brief     An allocator using a buffer on the stack first
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_STACK_ALLOCATOR_HPP_
+#define _DA_MEMORY_STACK_ALLOCATOR_HPP_
+
+#include <da/config.hpp>
+#include <bit>     // for std::has_single_bit()
+#include <cstddef> // for std::max_align_t
+#include <cstdint> // for uintptr_t
+#include <limits>
+#include <new>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A buffer of @tparam N bytes, usually a local variable, allocated from by stack_allocator
+ * @note  Allocation only moves a pointer forward, and only the last allocation is reclaimed on deallocation,
+ *        like da::arena. Allocations not fitting in the buffer go to the heap & are freed individually
+ * @note  A growing string leaves its old buffers behind, so N should be about twice the expected length
+ */
+template<size_t N>
+class stack_buffer {
+	alignas(std::max_align_t) char m_data[N];
+	char* m_cur = m_data;
+
+	public:
+	static inline constexpr size_t size = N;
+
+	public: // Constructors
+	stack_buffer() noexcept = default;
+
+	stack_buffer(const stack_buffer&)            = delete;
+	stack_buffer& operator=(const stack_buffer&) = delete;
+
+	public: // Allocation
+	/// Allocate @param n bytes aligned to @param align, which must be a power of 2
+	[[nodiscard]] void* allocate(size_t n, size_t align = alignof(std::max_align_t)) {
+		DA_ASSERT(std::has_single_bit(align));
+		const uintptr_t p   = (reinterpret_cast<uintptr_t>(m_cur) + align - 1) & ~(align - 1);
+		const uintptr_t end = reinterpret_cast<uintptr_t>(m_data + N);
+		DA_IFLIKELY(p <= end && end - p >= n) {
+			m_cur = reinterpret_cast<char*>(p + n);
+			return reinterpret_cast<void*>(p);
+		}
+		return align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? ::operator new(n) : ::operator new(n, std::align_val_t(align));
+	}
+
+	/// Free @param p allocated by this buffer with the same @param n & @param align
+	void deallocate(void* p, size_t n, size_t align = alignof(std::max_align_t)) noexcept {
+		if(owns(p)) {
+			if(static_cast<char*>(p) + n == m_cur) {
+				m_cur = static_cast<char*>(p);
+			}
+		} else if(align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+			::operator delete(p, n);
+		} else {
+			::operator delete(p, n, std::align_val_t(align));
+		}
+	}
+
+	/// Whether @param p is in the buffer
+	bool owns(const void* p) const noexcept {
+		const uintptr_t x = reinterpret_cast<uintptr_t>(p);
+		return x >= reinterpret_cast<uintptr_t>(m_data) && x < reinterpret_cast<uintptr_t>(m_data + N);
+	}
+
+	/// The bytes of the buffer used, including those freed but not reclaimed
+	size_t used() const noexcept {
+		return static_cast<size_t>(m_cur - m_data);
+	}
+
+	/// Reuse the whole buffer, only when nothing allocated from it is alive
+	void reset() noexcept {
+		m_cur = m_data;
+	}
+};
+
+/**
+ * @brief An allocator allocating from a stack_buffer<N> first, then from the heap when it is exhausted
+ * @note  The buffer must outlive all allocations. Like arena_allocator, it is not propagated on assignment
+ *        or swap, and two allocators are equal if they use the same buffer
+ */
+template<typename T, size_t N>
+class stack_allocator {
+	template<typename U, size_t M>
+	friend class stack_allocator;
+
+	stack_buffer<N>* m_buffer;
+
+	public:
+	typedef T         value_type;
+	typedef size_t    size_type;
+	typedef ptrdiff_t difference_type;
+
+	template<typename U>
+	struct rebind {
+		typedef stack_allocator<U, N> other;
+	};
+
+	public: // Constructors
+	stack_allocator(stack_buffer<N>& b) noexcept
+		: m_buffer(&b) { }
+
+	template<typename U>
+	stack_allocator(const stack_allocator<U, N>& a) noexcept
+		: m_buffer(a.m_buffer) { }
+
+	public: // Allocation
+	[[nodiscard]] T* allocate(size_type n) {
+		DA_IFUNLIKELY(n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+			DA_THROW(std::bad_array_new_length());
+		}
+		return static_cast<T*>(m_buffer->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* p, size_type n) noexcept {
+		m_buffer->deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	stack_buffer<N>& buffer() const noexcept {
+		return *m_buffer;
+	}
+
+	template<typename U>
+	friend bool operator==(const stack_allocator& a, const stack_allocator<U, N>& b) noexcept {
+		return &a.buffer() == &b.buffer();
+	}
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_MEMORY_STACK_ALLOCATOR_HPP_
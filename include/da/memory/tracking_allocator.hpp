@@ -0,0 +1,327 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      tracking_allocator.hpp
+ * @brief     An allocator wrapper collecting allocation statistics
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_MEMORY_TRACKING_ALLOCATOR_HPP_
+#define _DA_MEMORY_TRACKING_ALLOCATOR_HPP_
+
+#include <da/config.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>     // for std::bit_width()
+#include <memory>  // for std::allocator, std::allocator_traits
+#include <mutex>
+#include <utility> // for std::exchange()
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief The allocation statistics of a subsystem, see tracking_allocator
+ * @note  Each thread counts into its own counters without any read-modify-write,
+ *        which are summed up by snapshot(). The counters of an exited thread are merged into the total
+ * @note  The bytes in use are also published to a shared counter once a thread has allocated or freed
+ *        flush_threshold bytes since the last time. So peak_bytes is exact for a single thread,
+ *        and at most (threads - 1) * flush_threshold below the real peak otherwise
+ * @note  The threads without counters, e.g. freeing memory before attaching or after detaching,
+ *        count into shared counters by atomic read-modify-writes instead
+ */
+class allocation_stats {
+	public:
+	static inline constexpr size_t    histogram_size  = 16;
+	static inline constexpr ptrdiff_t flush_threshold = 16 * 1024;
+
+	struct snapshot_type {
+		size_t allocations       = 0;
+		size_t deallocations     = 0;
+		size_t allocated_bytes   = 0;
+		size_t deallocated_bytes = 0;
+		size_t bytes_in_use      = 0;
+		size_t peak_bytes        = 0;
+		/// The number of allocations of n bytes, in the bin std::bit_width(n),
+		/// i.e. [2^(i-1), 2^i) for bin i, the last bin holds all larger sizes
+		size_t histogram[histogram_size] = {};
+	};
+
+	/// The counters of a thread, only written by that thread
+	struct alignas(64) counters { // Not to share cache lines with other threads
+		std::atomic<size_t> allocations{0};
+		std::atomic<size_t> deallocations{0};
+		std::atomic<size_t> allocated_bytes{0};
+		std::atomic<size_t> deallocated_bytes{0};
+		std::atomic<size_t> peak_bytes{0};
+		std::atomic<size_t> histogram[histogram_size] = {};
+		ptrdiff_t           pending = 0; // The bytes not yet published to m_in_use
+		counters*           next    = nullptr;
+
+		static void _S_add(std::atomic<size_t>& c, size_t n) noexcept {
+			c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+	};
+
+	public: // Constructors
+	constexpr allocation_stats() noexcept = default;
+
+	allocation_stats(const allocation_stats&)            = delete;
+	allocation_stats& operator=(const allocation_stats&) = delete;
+
+	public: // Recording
+	void record_allocate(counters& c, size_t n) noexcept {
+		counters::_S_add(c.allocations, 1);
+		counters::_S_add(c.allocated_bytes, n);
+		counters::_S_add(c.histogram[std::min<size_t>(std::bit_width(n), histogram_size - 1)], 1);
+		c.pending += static_cast<ptrdiff_t>(n);
+		const ptrdiff_t in_use = _M_publish(c);
+		if(in_use > 0 && static_cast<size_t>(in_use) > c.peak_bytes.load(std::memory_order_relaxed)) {
+			c.peak_bytes.store(static_cast<size_t>(in_use), std::memory_order_relaxed);
+		}
+	}
+
+	void record_deallocate(counters& c, size_t n) noexcept {
+		counters::_S_add(c.deallocations, 1);
+		counters::_S_add(c.deallocated_bytes, n);
+		c.pending -= static_cast<ptrdiff_t>(n);
+		_M_publish(c);
+	}
+
+	/// Record an allocation of a thread without counters into the shared ones
+	void record_allocate(size_t n) noexcept {
+		m_shared.allocations.fetch_add(1, std::memory_order_relaxed);
+		m_shared.allocated_bytes.fetch_add(n, std::memory_order_relaxed);
+		m_shared.histogram[std::min<size_t>(std::bit_width(n), histogram_size - 1)].fetch_add(1, std::memory_order_relaxed);
+		const ptrdiff_t in_use = m_in_use.fetch_add(static_cast<ptrdiff_t>(n), std::memory_order_relaxed) + static_cast<ptrdiff_t>(n);
+		size_t          peak   = m_shared.peak_bytes.load(std::memory_order_relaxed);
+		while(in_use > 0 && static_cast<size_t>(in_use) > peak) {
+			if(m_shared.peak_bytes.compare_exchange_weak(peak, static_cast<size_t>(in_use), std::memory_order_relaxed)) {
+				break;
+			}
+		}
+	}
+
+	/// Record a deallocation of a thread without counters into the shared ones
+	void record_deallocate(size_t n) noexcept {
+		m_shared.deallocations.fetch_add(1, std::memory_order_relaxed);
+		m_shared.deallocated_bytes.fetch_add(n, std::memory_order_relaxed);
+		m_in_use.fetch_sub(static_cast<ptrdiff_t>(n), std::memory_order_relaxed);
+	}
+
+	/// Register new counters for the calling thread
+	[[nodiscard]] counters* attach() {
+		counters* const c = new counters;
+		std::lock_guard lock(m_mutex);
+		c->next   = m_threads;
+		m_threads = c;
+		return c;
+	}
+
+	/// Merge the counters of an exiting thread into the total and free them
+	void detach(counters* c) noexcept {
+		std::lock_guard lock(m_mutex);
+		m_in_use.fetch_add(std::exchange(c->pending, 0), std::memory_order_relaxed);
+		_S_merge(m_exited, *c);
+		for(counters** p = &m_threads; *p != nullptr; p = &(*p)->next) {
+			if(*p == c) {
+				*p = c->next;
+				break;
+			}
+		}
+		delete c;
+	}
+
+	public: // Observers
+	/// Sum up the counters of all threads, the allocations racing with it may be partially counted
+	[[nodiscard]] snapshot_type snapshot() const {
+		std::lock_guard lock(m_mutex);
+		snapshot_type   s = m_exited;
+		_S_merge(s, m_shared);
+		for(const counters* c = m_threads; c != nullptr; c = c->next) {
+			_S_merge(s, *c);
+		}
+		// A block freed by another thread during the sweep may be counted as freed but not as allocated
+		const ptrdiff_t in_use = static_cast<ptrdiff_t>(s.allocated_bytes - s.deallocated_bytes);
+		s.bytes_in_use         = in_use > 0 ? static_cast<size_t>(in_use) : 0;
+		s.peak_bytes           = std::max(s.peak_bytes, s.bytes_in_use);
+		return s;
+	}
+
+	private: // Internal functions
+	/// Publish the pending bytes of @param c if there are enough, and return the bytes in use seen by this thread
+	ptrdiff_t _M_publish(counters& c) noexcept {
+		DA_IFUNLIKELY(c.pending >= flush_threshold || c.pending <= -flush_threshold) {
+			const ptrdiff_t n = std::exchange(c.pending, 0);
+			return m_in_use.fetch_add(n, std::memory_order_relaxed) + n;
+		}
+		return m_in_use.load(std::memory_order_relaxed) + c.pending;
+	}
+
+	static void _S_merge(snapshot_type& s, const counters& c) noexcept {
+		s.allocations += c.allocations.load(std::memory_order_relaxed);
+		s.deallocations += c.deallocations.load(std::memory_order_relaxed);
+		s.allocated_bytes += c.allocated_bytes.load(std::memory_order_relaxed);
+		s.deallocated_bytes += c.deallocated_bytes.load(std::memory_order_relaxed);
+		s.peak_bytes = std::max(s.peak_bytes, c.peak_bytes.load(std::memory_order_relaxed));
+		for(size_t i = 0; i < histogram_size; ++i) {
+			s.histogram[i] += c.histogram[i].load(std::memory_order_relaxed);
+		}
+	}
+
+	mutable std::mutex     m_mutex;            // Guards the list of threads
+	counters*              m_threads = nullptr;
+	snapshot_type          m_exited;
+	counters               m_shared; // Of the threads without counters
+	std::atomic<ptrdiff_t> m_in_use{0};
+};
+
+/// The statistics of the subsystem @tparam Tag, alive until the process exits
+template<typename Tag>
+inline constinit allocation_stats allocation_stats_of{};
+
+DA_END_NAMESPACE
+
+DA_BEGIN_DETAIL
+
+/**
+ * @brief The counters of a thread for allocation_stats_of<Tag>
+ * @note  Trivially destructible, so that it is still valid in the destructors of other thread-local objects
+ */
+struct tracking_state {
+	_DA allocation_stats::counters* counters = nullptr;
+	bool                            exited   = false; // Detached by the exiting thread, never attached again
+};
+
+template<typename Tag>
+inline thread_local constinit tracking_state tracking_state_of{};
+
+/// Detaches the counters of the calling thread when it exits
+template<typename Tag>
+class tracking_local {
+	public:
+	constexpr tracking_local() noexcept = default;
+
+	tracking_local(const tracking_local&)            = delete;
+	tracking_local& operator=(const tracking_local&) = delete;
+
+	~tracking_local() {
+		tracking_state& s = tracking_state_of<Tag>;
+		s.exited          = true;
+		if(s.counters != nullptr) {
+			_DA allocation_stats_of<Tag>.detach(std::exchange(s.counters, nullptr));
+		}
+	}
+
+	/// The counters of the calling thread, attached on first use, nullptr once the thread is exiting
+	static _DA allocation_stats::counters* get();
+
+	/// The counters of the calling thread if attached, never allocating
+	static _DA allocation_stats::counters* find() noexcept {
+		return tracking_state_of<Tag>.counters;
+	}
+};
+
+template<typename Tag>
+inline thread_local tracking_local<Tag> tracking_local_of;
+
+template<typename Tag>
+_DA allocation_stats::counters* tracking_local<Tag>::get() {
+	tracking_state& s = tracking_state_of<Tag>;
+	DA_IFUNLIKELY(s.counters == nullptr && !s.exited) {
+		(void)&tracking_local_of<Tag>; // Constructs it, so that the counters are detached at exit
+		s.counters = _DA allocation_stats_of<Tag>.attach();
+	}
+	return s.counters;
+}
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief  An allocator forwarding to @tparam Alloc, which counts all allocations into allocation_stats_of<Tag>
+ * @tparam Tag Identifies the subsystem, e.g. an incomplete struct declared by it
+ * @note   It is meant to be used in production, tracking only adds a few uncontended stores to each call
+ */
+template<typename Alloc = std::allocator<char>, typename Tag = void>
+class tracking_allocator {
+	template<typename A, typename T>
+	friend class tracking_allocator;
+
+	typedef std::allocator_traits<Alloc> alloc_traits;
+
+	[[no_unique_address]] Alloc m_alloc;
+
+	public:
+	typedef typename alloc_traits::value_type      value_type;
+	typedef typename alloc_traits::pointer         pointer;
+	typedef typename alloc_traits::size_type       size_type;
+	typedef typename alloc_traits::difference_type difference_type;
+
+	typedef typename alloc_traits::propagate_on_container_copy_assignment propagate_on_container_copy_assignment;
+	typedef typename alloc_traits::propagate_on_container_move_assignment propagate_on_container_move_assignment;
+	typedef typename alloc_traits::propagate_on_container_swap            propagate_on_container_swap;
+	typedef typename alloc_traits::is_always_equal                        is_always_equal;
+
+	template<typename U>
+	struct rebind {
+		typedef tracking_allocator<typename alloc_traits::template rebind_alloc<U>, Tag> other;
+	};
+
+	public: // Constructors
+	constexpr tracking_allocator() noexcept(noexcept(Alloc())) = default;
+
+	constexpr explicit tracking_allocator(const Alloc& a) noexcept
+		: m_alloc(a) { }
+
+	template<typename A>
+	constexpr tracking_allocator(const tracking_allocator<A, Tag>& a) noexcept
+		: m_alloc(a.m_alloc) { }
+
+	public: // Allocation
+	[[nodiscard]] pointer allocate(size_type n) {
+		allocation_stats::counters* const c = _DA_DETAIL tracking_local<Tag>::get(); // May throw, so before allocating
+		pointer const                     p = alloc_traits::allocate(m_alloc, n);
+		if(c != nullptr) {
+			allocation_stats_of<Tag>.record_allocate(*c, n * sizeof(value_type));
+		} else {
+			allocation_stats_of<Tag>.record_allocate(n * sizeof(value_type));
+		}
+		return p;
+	}
+
+	/// Never attaches new counters, which may throw
+	void deallocate(pointer p, size_type n) noexcept {
+		alloc_traits::deallocate(m_alloc, p, n);
+		allocation_stats::counters* const c = _DA_DETAIL tracking_local<Tag>::find();
+		if(c != nullptr) {
+			allocation_stats_of<Tag>.record_deallocate(*c, n * sizeof(value_type));
+		} else {
+			allocation_stats_of<Tag>.record_deallocate(n * sizeof(value_type));
+		}
+	}
+
+	tracking_allocator select_on_container_copy_construction() const {
+		return tracking_allocator(alloc_traits::select_on_container_copy_construction(m_alloc));
+	}
+
+	public: // Observers
+	const Alloc& underlying() const noexcept {
+		return m_alloc;
+	}
+
+	static allocation_stats& stats() noexcept {
+		return allocation_stats_of<Tag>;
+	}
+
+	template<typename A>
+	friend constexpr bool operator==(const tracking_allocator& a, const tracking_allocator<A, Tag>& b) noexcept {
+		return a.m_alloc == b.m_alloc;
+	}
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_MEMORY_TRACKING_ALLOCATOR_HPP_
@@ -12,7 +12,14 @@
 #define _DA_STRING_HPP_
 
 #include <da/config.hpp>
+#include <da/memory/stack_allocator.hpp>
+#include <da/string/convert.hpp>
+#include <da/string/encoding.hpp>
+#include <da/string/interner.hpp>
+#include <da/string/lazy_string.hpp>
+#include <da/string/mapped_string.hpp>
 #include <da/string/normal_string.hpp>
+#include <da/string/split.hpp>
 #include <da/string/sso_string.hpp>
 #include <da/string/string_fwd.hpp>
 #include <da/type_traits.hpp>
@@ -76,6 +83,7 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 	DA_DECLARE_MEMBER_FUNCTION_TEST(has__M_limit_length_i_i, _M_limit_length, size_type, size_type)
 
 	DA_DECLARE_MEMBER_FUNCTION_TEST(has_data, data)
+	DA_DECLARE_MEMBER_FUNCTION_TEST(has_c_str, c_str)
 	DA_DECLARE_MEMBER_FUNCTION_TEST(has_size, size)
 	DA_DECLARE_MEMBER_FUNCTION_TEST(has_capacity, capacity)
 	DA_DECLARE_MEMBER_FUNCTION_TEST(has_max_size, max_size)
@@ -140,17 +148,23 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 	DA_DECLARE_MEMBER_FUNCTION_TEST(has_operator_equal_scr, operator+=, const Self&)
 	DA_DECLARE_MEMBER_FUNCTION_TEST(has_operator_equal_v, operator+=, value_type)
 
-	DA_DECLARE_MEMBER_FUNCTION_TEST(has_swap_scr, swap, const Self&)
+	DA_DECLARE_MEMBER_FUNCTION_TEST(has_swap_sr, swap, Self&)
 
 	public: // Constructors
-	DA_CONSTEXPR string_base() noexcept {
+	DA_CONSTEXPR string_base() noexcept
+		: string_base(allocator_type()) { }
+
+	// The allocator is kept by the string, e.g. da::arena_allocator for allocating from an arena
+	DA_CONSTEXPR explicit string_base(const allocator_type& a)
+		: Impl(a) {
 		size_type c = start_capacity;
 		_M_data(_M_create(c, 0));
 		_M_capacity(c);
 		_M_size(0);
 	}
 
-	DA_CONSTEXPR string_base(const_pointer s, size_type n) {
+	DA_CONSTEXPR string_base(const_pointer s, size_type n, const allocator_type& a = allocator_type())
+		: Impl(a) {
 		size_type c = n;
 		_M_data(_M_create(c, 0));
 		_M_capacity(c);
@@ -158,7 +172,8 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 		_M_size(n);
 	}
 
-	DA_CONSTEXPR string_base(size_type n, value_type v) {
+	DA_CONSTEXPR string_base(size_type n, value_type v, const allocator_type& a = allocator_type())
+		: Impl(a) {
 		size_type c = n;
 		_M_data(_M_create(c, 0));
 		_M_capacity(c);
@@ -166,12 +181,19 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 		_M_size(n);
 	}
 
-	DA_CONSTEXPR string_base(Self&& s) {
-		swap(move(s));
+	/**
+	 * @brief Take the content & the allocator of @param s, so that the memory is always freed by the allocator allocating it
+	 * @note  @param s is left empty, which allocates start_capacity by its allocator unless the policy has an inline buffer,
+	 *        so it may throw, e.g. std::bad_alloc, and uses up the space of arena & stack allocators
+	 */
+	DA_CONSTEXPR string_base(Self&& s)
+		: string_base(s._M_get_alloc()) {
+		swap(s);
 	}
 
 	template<forward_iterator Iter>
-	DA_CONSTEXPR string_base(Iter it1, Iter it2) {
+	DA_CONSTEXPR string_base(Iter it1, Iter it2, const allocator_type& a = allocator_type())
+		: Impl(a) {
 		// TODO: Optimize this to avoid access two times, thus we can accept input iterator
 		const size_type n = std::distance(it1, it2);
 		size_type       c = n;
@@ -181,20 +203,25 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 		_M_size(n);
 	}
 
-	DA_CONSTEXPR string_base(const_pointer s)
-		: string_base(s, _S_length(s)) { }
+	DA_CONSTEXPR string_base(const_pointer s, const allocator_type& a = allocator_type())
+		: string_base(s, _S_length(s), a) { }
 
 	DA_CONSTEXPR string_base(const Self& s)
-		: string_base(s.data(), s.size()) { }
+		: string_base(s.data(), s.size(), alloc_traits::select_on_container_copy_construction(s._M_get_alloc())) { }
+
+	DA_CONSTEXPR string_base(const Self& s, const allocator_type& a)
+		: string_base(s.data(), s.size(), a) { }
 
 	DA_CONSTEXPR string_base(const Self& s, size_type pos)
-		: string_base(s.data() + s._M_check_pos(pos, "da::string_base::string_base"), s._M_limit_length(pos, npos)) { }
+		: string_base(s.data() + s._M_check_pos(pos, "da::string_base::string_base"), s._M_limit_length(pos, npos),
+					  alloc_traits::select_on_container_copy_construction(s._M_get_alloc())) { }
 
 	DA_CONSTEXPR string_base(const Self& s, size_type pos, size_type n)
-		: string_base(s.data() + s._M_check_pos(pos, "da::string_base::string_base"), s._M_limit_length(pos, n)) { }
+		: string_base(s.data() + s._M_check_pos(pos, "da::string_base::string_base"), s._M_limit_length(pos, n),
+					  alloc_traits::select_on_container_copy_construction(s._M_get_alloc())) { }
 
-	DA_CONSTEXPR string_base(std::initializer_list<value_type> il)
-		: string_base(il.begin(), il.size()) { }
+	DA_CONSTEXPR string_base(std::initializer_list<value_type> il, const allocator_type& a = allocator_type())
+		: string_base(il.begin(), il.size(), a) { }
 
 	DA_CONSTEXPR ~string_base() {
 		_M_dispose();
@@ -398,6 +425,17 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 		static_assert(has_data_v<const Impl>, "The implemention of string should provide `pointer data() const` as interface.");
 	}
 
+	/**
+	 * @brief Get the string terminated by '\0'
+	 * @note  The implemention may write the terminator lazily here instead of in _M_size()
+	 */
+	DA_CONSTEXPR const_pointer c_str() const noexcept {
+		if constexpr(has_c_str_v<const Impl>) {
+			return Impl::c_str();
+		}
+		return data();
+	}
+
 	DA_CONSTEXPR size_type size() const noexcept {
 		if constexpr(has_size_v<const Impl>) {
 			return Impl::size();
@@ -533,7 +571,7 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 			return;
 		}
 		// since it will only extend the capacity, so just return back
-		DA_IFUNLIKELY(n < capacity()) {
+		DA_IFUNLIKELY(n <= capacity()) {
 			return;
 		}
 		pointer p = _M_create(n, capacity());
@@ -565,6 +603,20 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 		return size() == 0;
 	}
 
+	/**
+	 * @brief Write at most @param n characters into the string directly, like std::string::resize_and_overwrite of C++23
+	 * @param op Called as op(data(), n), where [size(), n) is uninitialized.
+	 *           It returns the new size, which must not exceed n
+	 * @note  The size is only updated once after @param op returns, so nothing is written twice
+	 */
+	template<typename Op>
+	DA_CONSTEXPR void resize_and_overwrite(size_type n, Op op) {
+		reserve(n);
+		const auto m = static_cast<size_type>(std::move(op)(data(), n));
+		assert(m <= n);
+		_M_size(m);
+	}
+
 	public: // Member access
 	DA_CONSTEXPR reference operator[](size_type n) {
 		if constexpr(has_operator_square_i_v<Impl>) {
@@ -861,9 +913,11 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 			Impl::push_back(c);
 			return;
 		}
-		size_type s = size();
-		if(s == capacity()) {
+		const size_type s = size();
+		DA_IFUNLIKELY(s == capacity()) {
 			replace(s, 0, nullptr, 1); // Extend the string length
+		} else {
+			_M_size(s + 1);
 		}
 		_S_assign(data()[s], c);
 	}
@@ -912,7 +966,12 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 		if constexpr(has_assign_sR_v<Impl>) {
 			return Impl::assign(s);
 		}
-		swap(move(s));
+		if constexpr(!alloc_traits::is_always_equal::value) {
+			if(_M_get_alloc() != s._M_get_alloc()) { // Cannot take the memory of another allocator
+				return assign(s.data(), s.size());
+			}
+		}
+		swap(s);
 		return *this;
 	}
 
@@ -960,19 +1019,31 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 		if constexpr(has_operator_equal_sR_v<Impl>) {
 			return Impl::operator=(s);
 		}
+		return assign(std::move(s));
+	}
+
+	DA_CONSTEXPR Self& operator=(const Self& s) {
 		return assign(s);
 	}
 
 	public: // Others
-	DA_CONSTEXPR void swap(const Self& s) {
-		if constexpr(has_swap_scr_v<Impl>) {
+	DA_CONSTEXPR operator std::basic_string_view<value_type, traits_type>() const noexcept {
+		return {data(), size()};
+	}
+
+	DA_CONSTEXPR allocator_type get_allocator() const noexcept {
+		return _M_get_alloc();
+	}
+
+	DA_CONSTEXPR void swap(Self& s) noexcept {
+		if constexpr(has_swap_sr_v<Impl>) {
 			Impl::swap(s);
 			return;
 		}
 		const pointer p = data();
 		_M_data(s.data());
 		s._M_data(p);
-		const size_type c = capacity();
+		size_type c = capacity();
 		_M_capacity(s.capacity());
 		s._M_capacity(c);
 		c = size();
@@ -981,6 +1052,11 @@ class string_base : protected StringImpl<Char, Traits, Alloc> { // Not public in
 	}
 };
 
+/// A string is relocatable if its implemention is
+template<typename Char, typename Traits, typename Alloc,
+		 template<typename, typename, typename> typename StringImpl>
+struct is_trivially_relocatable<string_base<Char, Traits, Alloc, StringImpl>> : is_trivially_relocatable<StringImpl<Char, Traits, Alloc>> { };
+
 DA_END_NAMESPACE
 
 #endif // _DA_STRING_HPP_
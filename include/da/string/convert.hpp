@@ -0,0 +1,94 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      convert.hpp
+ * @brief     Convert between numbers and strings without going through fmt
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_STRING_CONVERT_HPP_
+#define _DA_STRING_CONVERT_HPP_
+
+#include <da/config.hpp>
+#include <da/format.hpp>
+#include <da/string/string_fwd.hpp>
+#include <da/utility/charconv.hpp>
+#include <da/utility/number.hpp>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+DA_BEGIN_DETAIL
+
+/// An upper bound of the characters written by to_chars(first, last, T), 0 if not supported
+template<typename T>
+inline constexpr size_t max_chars = 0;
+
+template<char_convertible_integral T>
+inline constexpr size_t max_chars<T> = std::numeric_limits<T>::digits10 + 2; // Sign & the partial digit
+
+// "-d.ddde-dddd" in the worst case, the fixed notation is only used when it is shorter
+template<floating_point T>
+inline constexpr size_t max_chars<T> = std::numeric_limits<T>::max_digits10 + 8;
+
+// "-0.000ddd" for small numbers
+template<size_t P, integral B>
+inline constexpr size_t max_chars<fixed_point<P, B>> = std::numeric_limits<B>::digits10 + P + 3;
+
+template<typename T>
+concept number_convertible = max_chars<T> != 0;
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief Append @param value in decimal to @param s, like s += std::to_string(value) without the temporary
+ * @note  The digits are written into the buffer of @param s directly and the size is updated once
+ */
+template<typename Traits, typename Alloc, template<typename, typename, typename> typename StringImpl,
+		 _DA_DETAIL number_convertible T>
+DA_CONSTEXPR string_base<char, Traits, Alloc, StringImpl>& append_number(string_base<char, Traits, Alloc, StringImpl>& s, T value) {
+	const size_t old = s.size();
+	s.resize_and_overwrite(old + _DA_DETAIL max_chars<T>, [old, value](char* p, size_t n) {
+		return static_cast<size_t>(to_chars(p + old, p + n, value).ptr - p);
+	});
+	return s;
+}
+
+/**
+ * @brief  Convert @param value to a string in decimal
+ * @tparam String Any string_base of char, da::string by default
+ * @note   Integers are the same as std::to_string(), while floating point uses the shortest representation that round trips
+ */
+template<typename String = string, _DA_DETAIL number_convertible T>
+[[nodiscard]] DA_CONSTEXPR String to_string(T value) {
+	char       buf[_DA_DETAIL max_chars<T>];
+	const auto r = to_chars(buf, buf + sizeof(buf), value);
+	return String(buf, static_cast<size_t>(r.ptr - buf));
+}
+
+/**
+ * @brief  Parse the whole @param s as a number of type T
+ * @throw  std::invalid_argument if @param s is not a number, or there are extra characters after it
+ * @throw  std::out_of_range if the number doesn't fit in T
+ */
+template<_DA_DETAIL number_convertible T>
+[[nodiscard]] DA_CONSTEXPR T parse(std::string_view s) {
+	T          value{};
+	const auto last = s.data() + s.size();
+	const auto r    = from_chars(s.data(), last, value);
+	DA_IFUNLIKELY(r.ec == std::errc::result_out_of_range) {
+		DA_THROW(std::out_of_range(fmt::format("da::parse: \"{}\" is out of range", s)));
+	}
+	DA_IFUNLIKELY(r.ec != std::errc() || r.ptr != last) {
+		DA_THROW(std::invalid_argument(fmt::format("da::parse: \"{}\" is not a valid number", s)));
+	}
+	return value;
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_STRING_CONVERT_HPP_
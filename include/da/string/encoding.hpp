@@ -0,0 +1,484 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      encoding.hpp
+ * @brief     ASCII check, hex & base64 encoding
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_STRING_ENCODING_HPP_
+#define _DA_STRING_ENCODING_HPP_
+
+#include <da/config.hpp>
+#include <da/string/string_fwd.hpp>
+#include <array>
+#include <bit>          // for std::countr_zero()
+#include <string_view>
+#include <system_error> // for std::errc
+#include <type_traits>  // for std::is_constant_evaluated()
+#if DA_HAS_SSSE3
+	#include <immintrin.h>
+#elif DA_HAS_SSE2
+	#include <emmintrin.h>
+#endif
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief The result of decoding, like std::from_chars_result
+ */
+struct decode_result {
+	size_t    position; // Of the first invalid character, or the size of the input on success
+	std::errc ec;       // std::errc() on success, or std::errc::invalid_argument
+
+	constexpr explicit operator bool() const noexcept {
+		return ec == std::errc();
+	}
+};
+
+DA_END_NAMESPACE
+
+DA_BEGIN_DETAIL
+
+inline constexpr char hex_digits[2][17] = {"0123456789abcdef", "0123456789ABCDEF"};
+
+inline constexpr char base64_digits[65] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/// The value of each character in @param digits, or 0xFF if it is not one of them
+constexpr std::array<uint8_t, 256> make_decode_table(std::string_view digits) noexcept {
+	std::array<uint8_t, 256> t{};
+	t.fill(0xFF);
+	for(size_t i = 0; i < digits.size(); ++i) {
+		t[static_cast<unsigned char>(digits[i])] = static_cast<uint8_t>(i);
+	}
+	return t;
+}
+
+inline constexpr auto hex_values = [] {
+	auto t = make_decode_table(hex_digits[0]);
+	for(int i = 0; i < 6; ++i) {
+		t['A' + i] = static_cast<uint8_t>(10 + i);
+	}
+	return t;
+}();
+
+inline constexpr auto base64_values = make_decode_table(base64_digits);
+
+#if DA_HAS_SSSE3
+/// The nibbles of 16 hex characters, and set the bytes of @param valid for the valid ones
+inline __m128i hex_nibbles(__m128i c, __m128i& valid) noexcept {
+	const __m128i d = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+	const __m128i l = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a')); // Fold to lower case
+	// x <= y for unsigned bytes as min(x, y) == x, since SSSE3 has no unsigned comparison
+	const __m128i is_d = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+	const __m128i is_l = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+	valid              = _mm_or_si128(is_d, is_l);
+	return _mm_or_si128(_mm_and_si128(is_d, d), _mm_and_si128(is_l, _mm_add_epi8(l, _mm_set1_epi8(10))));
+}
+
+/// The 6-bit indices of the 16 base64 characters of 12 bytes in the low 12 bytes of @param x, from Wojciech Muła
+inline __m128i base64_indices(__m128i x) noexcept {
+	x                = _mm_shuffle_epi8(x, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+	const __m128i ac = _mm_mulhi_epu16(_mm_and_si128(x, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+	const __m128i bd = _mm_mullo_epi16(_mm_and_si128(x, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+	return _mm_or_si128(ac, bd);
+}
+
+/// Map the indices to characters by the offset of each range, selected by a saturated subtraction
+inline __m128i base64_chars(__m128i idx) noexcept {
+	const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+										  '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+	__m128i       r       = _mm_subs_epu8(idx, _mm_set1_epi8(51)); // 1 ~ 12 for digits, '+' & '/'
+	r                     = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+	return _mm_add_epi8(idx, _mm_shuffle_epi8(offsets, r));
+}
+
+/**
+ * @brief  The values of 16 base64 characters, packed into the low 12 bytes
+ * @return false if any character is invalid, including '='
+ * @note   Each character is classified by its low & high nibbles, from Wojciech Muła
+ */
+inline bool base64_values_of(__m128i c, __m128i& out) noexcept {
+	const __m128i lut_lo  = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+										  0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m128i lut_hi  = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+										  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	const __m128i lut_off = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i hi      = _mm_and_si128(_mm_srli_epi32(c, 4), _mm_set1_epi8(0x0F));
+	const __m128i lo      = _mm_and_si128(c, _mm_set1_epi8(0x0F));
+	const __m128i bad     = _mm_and_si128(_mm_shuffle_epi8(lut_lo, lo), _mm_shuffle_epi8(lut_hi, hi));
+	DA_IFUNLIKELY(_mm_movemask_epi8(_mm_cmpeq_epi8(bad, _mm_setzero_si128())) != 0xFFFF) {
+		return false;
+	}
+	// '/' shares the high nibble with '+', so it takes the offset before
+	const __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+	const __m128i v     = _mm_add_epi8(c, _mm_shuffle_epi8(lut_off, _mm_add_epi8(slash, hi)));
+	const __m128i ab_cd = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+	const __m128i abcd  = _mm_madd_epi16(ab_cd, _mm_set1_epi32(0x00011000));
+	out                 = _mm_shuffle_epi8(abcd, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+	return true;
+}
+#endif
+
+#if DA_HAS_AVX2
+/// The 256-bit version of the functions above, which work in each 128-bit lane
+inline __m256i hex_nibbles(__m256i c, __m256i& valid) noexcept {
+	const __m256i d    = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+	const __m256i l    = _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	const __m256i is_d = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+	const __m256i is_l = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+	valid              = _mm256_or_si256(is_d, is_l);
+	return _mm256_or_si256(_mm256_and_si256(is_d, d), _mm256_and_si256(is_l, _mm256_add_epi8(l, _mm256_set1_epi8(10))));
+}
+
+inline __m256i base64_indices(__m256i x) noexcept {
+	x                = _mm256_shuffle_epi8(x, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+															  10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+	const __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(x, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+	const __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(x, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+	return _mm256_or_si256(ac, bd);
+}
+
+inline __m256i base64_chars(__m256i idx) noexcept {
+	const __m256i offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+																	   '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0));
+	__m256i       r       = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+	r                     = _mm256_or_si256(r, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(13)));
+	return _mm256_add_epi8(idx, _mm256_shuffle_epi8(offsets, r));
+}
+
+inline bool base64_values_of(__m256i c, __m256i& out) noexcept {
+	const __m256i lut_lo  = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+																	  0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A));
+	const __m256i lut_hi  = _mm256_broadcastsi128_si256(_mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+																	  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10));
+	const __m256i lut_off = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0));
+	const __m256i hi      = _mm256_and_si256(_mm256_srli_epi32(c, 4), _mm256_set1_epi8(0x0F));
+	const __m256i lo      = _mm256_and_si256(c, _mm256_set1_epi8(0x0F));
+	const __m256i bad     = _mm256_and_si256(_mm256_shuffle_epi8(lut_lo, lo), _mm256_shuffle_epi8(lut_hi, hi));
+	DA_IFUNLIKELY(!_mm256_testz_si256(bad, bad)) {
+		return false;
+	}
+	const __m256i slash = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('/'));
+	const __m256i v     = _mm256_add_epi8(c, _mm256_shuffle_epi8(lut_off, _mm256_add_epi8(slash, hi)));
+	const __m256i ab_cd = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+	const __m256i abcd  = _mm256_madd_epi16(ab_cd, _mm256_set1_epi32(0x00011000));
+	out                 = _mm256_shuffle_epi8(abcd, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+																	 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+	return true;
+}
+#endif
+
+/// Write the 2 * @param n hex characters of [@param first, first + n) to @param out
+constexpr void encode_hex(const char* first, size_t n, char* out, bool uppercase) noexcept {
+	const char* const digits = hex_digits[uppercase];
+	size_t            i      = 0;
+#if DA_HAS_SSSE3
+	if(!std::is_constant_evaluated()) {
+	#if DA_HAS_AVX2
+		{
+			const __m256i lut  = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+			const __m256i mask = _mm256_set1_epi8(0x0F);
+			for(; n - i >= 32; i += 32) {
+				const __m256i x  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i));
+				const __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(x, 4), mask));
+				const __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(x, mask));
+				// Unpacking works in each lane, so the halves are swapped back
+				const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+				const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+			}
+		}
+	#endif
+		const __m128i lut  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+		const __m128i mask = _mm_set1_epi8(0x0F);
+		for(; n - i >= 16; i += 16) {
+			const __m128i x  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+			const __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), mask));
+			const __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(x, mask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+		}
+	}
+#endif
+	for(; i < n; ++i) {
+		const auto c   = static_cast<unsigned char>(first[i]);
+		out[2 * i]     = digits[c >> 4];
+		out[2 * i + 1] = digits[c & 0x0F];
+	}
+}
+
+/**
+ * @brief  Write the @param n / 2 bytes of the hex characters [@param first, first + n) to @param out
+ * @return The position of the first invalid character, or @param n on success
+ * @note   @param n must be even, and @param out may be partially written on failure
+ */
+constexpr size_t decode_hex(const char* first, size_t n, char* out) noexcept {
+	DA_ASSERT(n % 2 == 0);
+	size_t i = 0;
+#if DA_HAS_SSSE3
+	if(!std::is_constant_evaluated()) {
+	#if DA_HAS_AVX2
+		for(; n - i >= 64; i += 64) {
+			__m256i       v0, v1;
+			const __m256i n0 = hex_nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i)), v0);
+			const __m256i n1 = hex_nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i + 32)), v1);
+			const uint64_t bad = ~(static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(v0)))
+								   | static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(v1))) << 32);
+			DA_IFUNLIKELY(bad != 0) {
+				return i + static_cast<size_t>(std::countr_zero(bad));
+			}
+			// Each pair of nibbles to 16 * hi + lo in 16 bits, then pack in each lane & put the lanes back in order
+			const __m256i w0 = _mm256_maddubs_epi16(n0, _mm256_set1_epi16(0x0110));
+			const __m256i w1 = _mm256_maddubs_epi16(n1, _mm256_set1_epi16(0x0110));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2), _mm256_permute4x64_epi64(_mm256_packus_epi16(w0, w1), 0xD8));
+		}
+	#endif
+		for(; n - i >= 32; i += 32) {
+			__m128i        v0, v1;
+			const __m128i  n0  = hex_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i)), v0);
+			const __m128i  n1  = hex_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + 16)), v1);
+			const uint32_t bad = ~(static_cast<uint32_t>(_mm_movemask_epi8(v0)) | static_cast<uint32_t>(_mm_movemask_epi8(v1)) << 16);
+			DA_IFUNLIKELY(bad != 0) {
+				return i + static_cast<size_t>(std::countr_zero(bad));
+			}
+			const __m128i w0 = _mm_maddubs_epi16(n0, _mm_set1_epi16(0x0110));
+			const __m128i w1 = _mm_maddubs_epi16(n1, _mm_set1_epi16(0x0110));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), _mm_packus_epi16(w0, w1));
+		}
+	}
+#endif
+	for(; i < n; i += 2) {
+		const uint8_t hi = hex_values[static_cast<unsigned char>(first[i])];
+		const uint8_t lo = hex_values[static_cast<unsigned char>(first[i + 1])];
+		DA_IFUNLIKELY((hi | lo) == 0xFF) {
+			return hi == 0xFF ? i : i + 1;
+		}
+		out[i / 2] = static_cast<char>(hi << 4 | lo);
+	}
+	return n;
+}
+
+/// Write the base64 characters of [@param first, first + n) to @param out, with '=' padding
+constexpr void encode_base64(const char* first, size_t n, char* out) noexcept {
+	size_t i = 0;
+#if DA_HAS_SSSE3
+	// Each 12 bytes are loaded as 16, so the loops stop before the last 4 bytes
+	if(!std::is_constant_evaluated()) {
+	#if DA_HAS_AVX2
+		for(; n - i >= 28; i += 24, out += 32) {
+			const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+			const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i + 12));
+			const __m256i x  = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), base64_chars(base64_indices(x)));
+		}
+	#endif
+		for(; n - i >= 16; i += 12, out += 16) {
+			const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), base64_chars(base64_indices(x)));
+		}
+	}
+#endif
+	for(; n - i >= 3; i += 3, out += 4) {
+		const uint32_t x = static_cast<uint32_t>(static_cast<unsigned char>(first[i])) << 16
+						 | static_cast<uint32_t>(static_cast<unsigned char>(first[i + 1])) << 8
+						 | static_cast<uint32_t>(static_cast<unsigned char>(first[i + 2]));
+		out[0] = base64_digits[x >> 18];
+		out[1] = base64_digits[(x >> 12) & 0x3F];
+		out[2] = base64_digits[(x >> 6) & 0x3F];
+		out[3] = base64_digits[x & 0x3F];
+	}
+	if(i != n) {
+		const bool     two = n - i == 2;
+		const uint32_t x   = static_cast<uint32_t>(static_cast<unsigned char>(first[i])) << 16
+						 | (two ? static_cast<uint32_t>(static_cast<unsigned char>(first[i + 1])) << 8 : 0);
+		out[0] = base64_digits[x >> 18];
+		out[1] = base64_digits[(x >> 12) & 0x3F];
+		out[2] = two ? base64_digits[(x >> 6) & 0x3F] : '=';
+		out[3] = '=';
+	}
+}
+
+/**
+ * @brief  Write the bytes of the base64 characters [@param first, first + n) to @param out
+ * @return The position of the first invalid character, or @param n on success
+ * @note   @param n must be a multiple of 4, and only the last 2 characters may be '='
+ * @note   @param out should hold base64_decoded_size() bytes, it may be partially written on failure
+ */
+constexpr size_t decode_base64(const char* first, size_t n, char* out) noexcept {
+	DA_ASSERT(n % 4 == 0);
+	size_t i = 0;
+#if DA_HAS_SSSE3
+	// Each 12 bytes are stored as 16, so the loops leave enough characters for the padding & the last 4 bytes.
+	// A block with any invalid character, including the padding, is left to the scalar loop to find the position
+	if(!std::is_constant_evaluated()) {
+	#if DA_HAS_AVX2
+		for(__m256i v; n - i >= 48; i += 32, out += 24) {
+			DA_IFUNLIKELY(!base64_values_of(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i)), v)) {
+				break;
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(v));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm256_extracti128_si256(v, 1));
+		}
+	#endif
+		for(__m128i v; n - i >= 24; i += 16, out += 12) {
+			DA_IFUNLIKELY(!base64_values_of(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i)), v)) {
+				break;
+			}
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), v);
+		}
+	}
+#endif
+	for(; i < n; i += 4) {
+		uint32_t x    = 0;
+		size_t   size = 3;
+		for(size_t j = 0; j < 4; ++j) {
+			const char c = first[i + j];
+			// Only "xx==" & "xxx=" at the end
+			DA_IFUNLIKELY(c == '=' && i + 4 == n && j >= 2 && (j == 3 || first[i + 3] == '=')) {
+				size = j - 1;
+				x <<= 6 * (4 - j);
+				break;
+			}
+			const uint8_t v = base64_values[static_cast<unsigned char>(c)];
+			DA_IFUNLIKELY(v == 0xFF) {
+				return i + j;
+			}
+			x = x << 6 | v;
+		}
+		out[0] = static_cast<char>(x >> 16);
+		if(size > 1) {
+			out[1] = static_cast<char>(x >> 8);
+		}
+		if(size > 2) {
+			out[2] = static_cast<char>(x);
+		}
+		out += size;
+	}
+	return n;
+}
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief Whether all characters in @param s are ASCII
+ * @note  Use SSE2 to check 16 characters at a time
+ */
+[[nodiscard]] DA_CONSTEXPR bool is_ascii(std::string_view s) noexcept {
+	const char* first = s.data();
+	const char* last  = first + s.size();
+#if DA_HAS_SSE2
+	if(!std::is_constant_evaluated()) {
+		__m128i acc = _mm_setzero_si128();
+		for(; last - first >= 16; first += 16) {
+			acc = _mm_or_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(first)));
+		}
+		if(_mm_movemask_epi8(acc) != 0) {
+			return false;
+		}
+	}
+#endif
+	for(; first != last; ++first) {
+		if(static_cast<unsigned char>(*first) >= 0x80) {
+			return false;
+		}
+	}
+	return true;
+}
+
+[[nodiscard]] constexpr size_t hex_encoded_size(size_t n) noexcept {
+	return n * 2;
+}
+
+/// The exact size decoded from @param src, if it is valid
+[[nodiscard]] constexpr size_t hex_decoded_size(std::string_view src) noexcept {
+	return src.size() / 2;
+}
+
+[[nodiscard]] constexpr size_t base64_encoded_size(size_t n) noexcept {
+	return (n + 2) / 3 * 4;
+}
+
+/// The exact size decoded from @param src, if it is valid
+[[nodiscard]] constexpr size_t base64_decoded_size(std::string_view src) noexcept {
+	size_t n = src.size() / 4 * 3;
+	if(src.size() >= 4 && src.size() % 4 == 0) {
+		n -= (src.end()[-1] == '=') + (src.end()[-2] == '=');
+	}
+	return n;
+}
+
+/**
+ * @brief Append the hex of the bytes in @param src to @param dst, e.g. "\x12\xAB" to "12ab"
+ * @note  The output is written into the buffer of @param dst directly, with the exact size
+ */
+template<typename Traits, typename Alloc, template<typename, typename, typename> typename StringImpl>
+DA_CONSTEXPR string_base<char, Traits, Alloc, StringImpl>& hex_encode(string_base<char, Traits, Alloc, StringImpl>& dst, std::string_view src, bool uppercase = false) {
+	const size_t old = dst.size();
+	dst.resize_and_overwrite(old + hex_encoded_size(src.size()), [&](char* p, size_t n) {
+		_DA_DETAIL encode_hex(src.data(), src.size(), p + old, uppercase);
+		return n;
+	});
+	return dst;
+}
+
+/**
+ * @brief  Append the bytes of the hex in @param src to @param dst, in either case
+ * @return The position of the first invalid character on failure, or src.size() if the size is odd.
+ *         @param dst is unchanged on failure
+ */
+template<typename Traits, typename Alloc, template<typename, typename, typename> typename StringImpl>
+DA_CONSTEXPR decode_result hex_decode(string_base<char, Traits, Alloc, StringImpl>& dst, std::string_view src) {
+	DA_IFUNLIKELY(src.size() % 2 != 0) {
+		return {src.size(), std::errc::invalid_argument};
+	}
+	const size_t old = dst.size();
+	size_t       pos = 0;
+	dst.resize_and_overwrite(old + hex_decoded_size(src), [&](char* p, size_t n) {
+		pos = _DA_DETAIL decode_hex(src.data(), src.size(), p + old);
+		return pos == src.size() ? n : old;
+	});
+	return {pos, pos == src.size() ? std::errc() : std::errc::invalid_argument};
+}
+
+/**
+ * @brief Append the base64 of the bytes in @param src to @param dst, with the standard alphabet & '=' padding
+ * @note  The output is written into the buffer of @param dst directly, with the exact size
+ */
+template<typename Traits, typename Alloc, template<typename, typename, typename> typename StringImpl>
+DA_CONSTEXPR string_base<char, Traits, Alloc, StringImpl>& base64_encode(string_base<char, Traits, Alloc, StringImpl>& dst, std::string_view src) {
+	const size_t old = dst.size();
+	dst.resize_and_overwrite(old + base64_encoded_size(src.size()), [&](char* p, size_t n) {
+		_DA_DETAIL encode_base64(src.data(), src.size(), p + old);
+		return n;
+	});
+	return dst;
+}
+
+/**
+ * @brief  Append the bytes of the padded base64 in @param src to @param dst
+ * @return The position of the first invalid character on failure, or src.size() if the size is not a multiple of 4.
+ *         @param dst is unchanged on failure
+ */
+template<typename Traits, typename Alloc, template<typename, typename, typename> typename StringImpl>
+DA_CONSTEXPR decode_result base64_decode(string_base<char, Traits, Alloc, StringImpl>& dst, std::string_view src) {
+	DA_IFUNLIKELY(src.size() % 4 != 0) {
+		return {src.size(), std::errc::invalid_argument};
+	}
+	const size_t old = dst.size();
+	size_t       pos = 0;
+	dst.resize_and_overwrite(old + base64_decoded_size(src), [&](char* p, size_t n) {
+		pos = _DA_DETAIL decode_base64(src.data(), src.size(), p + old);
+		return pos == src.size() ? n : old;
+	});
+	return {pos, pos == src.size() ? std::errc() : std::errc::invalid_argument};
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_STRING_ENCODING_HPP_
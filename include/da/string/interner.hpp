@@ -0,0 +1,365 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      interner.hpp
+ * @brief     Map strings to dense integer symbols
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_STRING_INTERNER_HPP_
+#define _DA_STRING_INTERNER_HPP_
+
+#include <da/config.hpp>
+#include <da/utility/hash.hpp>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <utility> // for std::pair
+#include <vector>
+
+DA_BEGIN_DETAIL
+
+/**
+ * @brief Append-only storage for the bytes of interned strings
+ * @note  Strings are stored contiguously and never move, so the views remain valid until destruction
+ */
+class intern_arena {
+	public:
+	static inline constexpr size_t min_block_size = 4096;
+	static inline constexpr size_t max_block_size = 1 << 20;
+
+	std::string_view store(std::string_view s) {
+		DA_IFUNLIKELY(s.size() > m_remain) {
+			m_block_size = std::min(m_block_size * 2, max_block_size);
+			const size_t n = std::max(m_block_size, s.size());
+			m_blocks.emplace_back(new char[n]);
+			m_current = m_blocks.back().get();
+			m_remain  = n;
+		}
+		char* const p = m_current;
+		if(!s.empty()) { // Both pointers may be null then
+			std::memcpy(p, s.data(), s.size());
+		}
+		m_current += s.size();
+		m_remain -= s.size();
+		m_bytes += s.size();
+		return {p, s.size()};
+	}
+
+	size_t bytes() const noexcept {
+		return m_bytes;
+	}
+
+	void clear() noexcept {
+		m_blocks.clear();
+		m_current    = nullptr;
+		m_remain     = 0;
+		m_bytes      = 0;
+		m_block_size = min_block_size / 2;
+	}
+
+	private:
+	std::vector<std::unique_ptr<char[]>> m_blocks;
+	char*                                m_current    = nullptr;
+	size_t                               m_remain     = 0;
+	size_t                               m_bytes      = 0;
+	size_t                               m_block_size = min_block_size / 2;
+};
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief Map strings to dense 32-bit symbols, so that comparing strings becomes comparing integers
+ * @note  Symbols are allocated from 0 in the order of first interning
+ * @note  The views returned remain valid until the interner is cleared or destroyed
+ */
+class string_interner {
+	public:
+	using symbol_t = uint32_t;
+
+	static inline DA_CONSTEXPR symbol_t invalid_symbol = std::numeric_limits<symbol_t>::max();
+
+	string_interner() = default;
+
+	string_interner(const string_interner&)            = delete;
+	string_interner& operator=(const string_interner&) = delete;
+
+	string_interner(string_interner&&) noexcept            = default;
+	string_interner& operator=(string_interner&&) noexcept = default;
+
+	/**
+	 * @brief  Get the symbol of @param s, intern it if not exists
+	 */
+	symbol_t intern(std::string_view s) {
+		DA_IFUNLIKELY(m_slots.empty()) {
+			_M_rehash(16);
+		}
+		const auto h   = static_cast<uint32_t>(hash(s));
+		size_t     pos = _M_probe(s, h);
+		DA_IFLIKELY(m_slots[pos].id != invalid_symbol) {
+			return m_slots[pos].id;
+		}
+		DA_IFUNLIKELY(m_views.size() >= invalid_symbol) {
+			DA_THROW(std::length_error("da::string_interner::intern: Too many symbols"));
+		}
+		DA_IFUNLIKELY((m_views.size() + 1) * 4 > m_slots.size() * 3) { // Keep load factor <= 0.75
+			_M_rehash(m_slots.size() * 2);
+			pos = _M_probe(s, h);
+		}
+		const auto id = static_cast<symbol_t>(m_views.size());
+		m_views.push_back(m_arena.store(s));
+		m_slots[pos] = {id, h};
+		return id;
+	}
+
+	/**
+	 * @brief  Get the symbol of @param s without interning
+	 * @return The symbol, or invalid_symbol if @param s is not interned
+	 */
+	symbol_t find(std::string_view s) const noexcept {
+		DA_IFUNLIKELY(m_slots.empty()) {
+			return invalid_symbol;
+		}
+		return m_slots[_M_probe(s, static_cast<uint32_t>(hash(s)))].id;
+	}
+
+	std::string_view view(symbol_t id) const noexcept {
+		DA_ASSERT(id < m_views.size());
+		return m_views[id];
+	}
+
+	std::string_view operator[](symbol_t id) const noexcept {
+		return view(id);
+	}
+
+	size_t size() const noexcept {
+		return m_views.size();
+	}
+
+	bool empty() const noexcept {
+		return m_views.empty();
+	}
+
+	/// Total bytes of all interned strings
+	size_t bytes() const noexcept {
+		return m_arena.bytes();
+	}
+
+	void reserve(size_t n) {
+		m_views.reserve(n);
+		const size_t c = std::bit_ceil(n + n / 3 + 1);
+		if(c > m_slots.size()) {
+			_M_rehash(c);
+		}
+	}
+
+	/// Forget all symbols, all views are invalidated
+	void clear() noexcept {
+		m_views.clear();
+		m_slots.clear();
+		m_arena.clear();
+	}
+
+	private:
+	struct slot {
+		symbol_t id   = invalid_symbol;
+		uint32_t hash = 0; // Low bits of the hash, to skip most string comparisons
+	};
+
+	// Return the position of @param s, or the empty slot to insert it
+	size_t _M_probe(std::string_view s, uint32_t h) const noexcept {
+		const size_t mask = m_slots.size() - 1;
+		for(size_t i = h & mask;; i = (i + 1) & mask) {
+			const slot& x = m_slots[i];
+			if(x.id == invalid_symbol || (x.hash == h && m_views[x.id] == s)) {
+				return i;
+			}
+		}
+	}
+
+	void _M_rehash(size_t n) {
+		std::vector<slot> slots(std::max<size_t>(n, 16));
+		const size_t      mask = slots.size() - 1;
+		for(const slot& x : m_slots) {
+			if(x.id != invalid_symbol) {
+				size_t i = x.hash & mask;
+				while(slots[i].id != invalid_symbol) {
+					i = (i + 1) & mask;
+				}
+				slots[i] = x;
+			}
+		}
+		m_slots = std::move(slots);
+	}
+
+	std::vector<std::string_view> m_views;
+	std::vector<slot>             m_slots;
+	_DA_DETAIL intern_arena       m_arena;
+};
+
+/**
+ * @brief Thread-safe version of string_interner
+ * @note  view() & find() never lock, intern() only locks when the string is not interned yet
+ * @note  Symbols and views may be freely passed between threads, clear() is not provided
+ */
+class concurrent_string_interner {
+	public:
+	using symbol_t = string_interner::symbol_t;
+
+	static inline DA_CONSTEXPR symbol_t invalid_symbol = string_interner::invalid_symbol;
+
+	concurrent_string_interner() {
+		m_tables.push_back(_S_make_table(64));
+		m_table.store(m_tables.back().get(), std::memory_order_relaxed);
+	}
+
+	concurrent_string_interner(const concurrent_string_interner&)            = delete;
+	concurrent_string_interner& operator=(const concurrent_string_interner&) = delete;
+
+	~concurrent_string_interner() {
+		for(auto& s : m_segments) {
+			delete[] s.load(std::memory_order_relaxed);
+		}
+	}
+
+	symbol_t intern(std::string_view s) {
+		const auto h = static_cast<uint32_t>(hash(s));
+		symbol_t   x = _M_find(m_table.load(std::memory_order_acquire), s, h);
+		DA_IFLIKELY(x != invalid_symbol) {
+			return x;
+		}
+		std::lock_guard lock(m_mutex);
+		table*          t = m_table.load(std::memory_order_relaxed);
+		x                 = _M_find(t, s, h); // Someone may have interned it before we get the lock
+		if(x != invalid_symbol) {
+			return x;
+		}
+		const size_t n = m_size.load(std::memory_order_relaxed);
+		DA_IFUNLIKELY(n >= invalid_symbol) {
+			DA_THROW(std::length_error("da::concurrent_string_interner::intern: Too many symbols"));
+		}
+		const auto id = static_cast<symbol_t>(n);
+
+		_M_new_entry(id) = m_arena.store(s);
+		DA_IFUNLIKELY((n + 1) * 4 > (t->mask + 1) * 3) {
+			t = _M_grow(t);
+		}
+		_S_insert(t, id, h);
+		m_size.store(n + 1, std::memory_order_release);
+		return id;
+	}
+
+	symbol_t find(std::string_view s) const noexcept {
+		return _M_find(m_table.load(std::memory_order_acquire), s, static_cast<uint32_t>(hash(s)));
+	}
+
+	std::string_view view(symbol_t id) const noexcept {
+		const auto [k, offset] = _S_locate(id);
+		const auto* const seg  = m_segments[k].load(std::memory_order_acquire);
+		DA_ASSERT(seg != nullptr);
+		return seg[offset];
+	}
+
+	std::string_view operator[](symbol_t id) const noexcept {
+		return view(id);
+	}
+
+	size_t size() const noexcept {
+		return m_size.load(std::memory_order_acquire);
+	}
+
+	bool empty() const noexcept {
+		return size() == 0;
+	}
+
+	private:
+	// Entries are stored in segments of doubling size, so they never move and can be read without locking
+	static inline constexpr size_t first_segment_bits = 10;
+	static inline constexpr size_t segment_count      = 23; // Enough to hold 2^32 entries
+
+	struct table {
+		size_t                                   mask;
+		std::unique_ptr<std::atomic<uint64_t>[]> slots; // (hash << 32) | (id + 1), 0 means empty
+	};
+
+	static std::unique_ptr<table> _S_make_table(size_t n) {
+		auto t   = std::make_unique<table>();
+		t->mask  = n - 1;
+		t->slots = std::make_unique<std::atomic<uint64_t>[]>(n);
+		return t;
+	}
+
+	static void _S_insert(table* t, symbol_t id, uint32_t h) noexcept {
+		size_t i = h & t->mask;
+		while(t->slots[i].load(std::memory_order_relaxed) != 0) {
+			i = (i + 1) & t->mask;
+		}
+		t->slots[i].store((uint64_t(h) << 32) | (uint64_t(id) + 1), std::memory_order_release);
+	}
+
+	// Return {segment, offset in segment} of @param id
+	static std::pair<size_t, size_t> _S_locate(symbol_t id) noexcept {
+		const size_t k = std::bit_width((size_t(id) >> first_segment_bits) + 1) - 1;
+		return {k, size_t(id) - (((size_t(1) << k) - 1) << first_segment_bits)};
+	}
+
+	std::string_view& _M_new_entry(symbol_t id) {
+		const auto [k, offset] = _S_locate(id);
+		auto* seg              = m_segments[k].load(std::memory_order_relaxed);
+		if(seg == nullptr) {
+			seg = new std::string_view[size_t(1) << (first_segment_bits + k)];
+			m_segments[k].store(seg, std::memory_order_release);
+		}
+		return seg[offset];
+	}
+
+	symbol_t _M_find(const table* t, std::string_view s, uint32_t h) const noexcept {
+		for(size_t i = h & t->mask;; i = (i + 1) & t->mask) {
+			const uint64_t x = t->slots[i].load(std::memory_order_acquire);
+			if(x == 0) {
+				return invalid_symbol;
+			}
+			if(static_cast<uint32_t>(x >> 32) == h) {
+				const auto id = static_cast<symbol_t>((x & 0xFFFFFFFF) - 1);
+				if(view(id) == s) {
+					return id;
+				}
+			}
+		}
+	}
+
+	// Readers may still be using the old table, so it is kept until destruction
+	table* _M_grow(const table* old) {
+		auto t = _S_make_table((old->mask + 1) * 2);
+		for(size_t i = 0; i <= old->mask; ++i) {
+			const uint64_t x = old->slots[i].load(std::memory_order_relaxed);
+			if(x != 0) {
+				_S_insert(t.get(), static_cast<symbol_t>((x & 0xFFFFFFFF) - 1), static_cast<uint32_t>(x >> 32));
+			}
+		}
+		table* const p = t.get();
+		m_tables.push_back(std::move(t));
+		m_table.store(p, std::memory_order_release);
+		return p;
+	}
+
+	std::atomic<table*>                 m_table{nullptr};
+	std::atomic<size_t>                 m_size{0};
+	std::atomic<std::string_view*>      m_segments[segment_count] = {};
+	std::mutex                          m_mutex;
+	std::vector<std::unique_ptr<table>> m_tables; // Guarded by m_mutex
+	_DA_DETAIL intern_arena             m_arena;  // Guarded by m_mutex
+};
+
+DA_END_NAMESPACE
+
+#endif // _DA_STRING_INTERNER_HPP_
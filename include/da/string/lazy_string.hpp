@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      lazy_string.hpp
+ * @brief     A normal string implemention writing '\0' only when required
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_STRING_LAZY_STRING_HPP_
+#define _DA_STRING_LAZY_STRING_HPP_
+
+#include <da/config.hpp>
+#include <da/string/normal_string.hpp>
+#include <da/string/string_fwd.hpp>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief Same as normal_string_base, except that changing the size doesn't write the terminator
+ * @note  The terminator is written by c_str(), so data()[size()] is unspecified before calling it
+ * @note  One more element is still allocated, thus c_str() never reallocates
+ * @note  Since c_str() writes even on a const string, unlike other policies,
+ *        calling it from several threads on a shared string is a data race
+ */
+template<typename Char, typename Traits, typename Alloc>
+class lazy_string_base : public normal_string_base<Char, Traits, Alloc> {
+	typedef normal_string_base<Char, Traits, Alloc> Base;
+
+	public:
+	typedef typename Base::size_type     size_type;
+	typedef typename Base::const_pointer const_pointer;
+
+	using Base::Base;
+
+	public: // Basic operations
+	DA_CONSTEXPR void _M_size(size_type n) noexcept {
+		assert(n <= this->capacity());
+		this->m_size = n;
+	}
+
+	DA_CONSTEXPR const_pointer c_str() const noexcept {
+		Base::_S_assign(this->data()[this->size()], Char());
+		return this->data();
+	}
+};
+
+template<typename Char, typename Traits, typename Alloc>
+struct is_trivially_relocatable<lazy_string_base<Char, Traits, Alloc>> : is_trivially_relocatable<Alloc> { };
+
+DA_END_NAMESPACE
+
+#endif // _DA_STRING_LAZY_STRING_HPP_
@@ -0,0 +1,212 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      mapped_string.hpp
+ * @brief     A read-only string backed by a memory-mapped file
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_STRING_MAPPED_STRING_HPP_
+#define _DA_STRING_MAPPED_STRING_HPP_
+
+#include <da/config.hpp>
+
+#if DA_UNIX // Only POSIX mmap is supported now
+
+	#include <da/format.hpp>
+	#include <da/memory/mapped_file.hpp>
+	#include <filesystem>
+	#include <iterator>
+	#include <limits>
+	#include <string>
+	#include <string_view>
+	#include <utility>
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A read-only string whose content is a file mapped into memory
+ * @note  It provides the const interface of string_base over a read-only mapped_file,
+ *        the file is unmapped when the string is destroyed
+ * @note  The content is NOT terminated by '\0'
+ */
+template<typename Char, typename Traits = std::char_traits<Char>>
+class basic_mapped_string {
+	typedef basic_mapped_string<Char, Traits> Self;
+
+	public:
+	typedef Traits                                traits_type;
+	typedef Char                                  value_type;
+	typedef size_t                                size_type;
+	typedef ssize_t                               difference_type;
+	typedef const Char*                           pointer;
+	typedef const Char*                           const_pointer;
+	typedef const Char&                           reference;
+	typedef const Char&                           const_reference;
+	typedef const Char*                           iterator;
+	typedef const Char*                           const_iterator;
+	typedef std::reverse_iterator<iterator>       reverse_iterator;
+	typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+	static inline DA_CONSTEXPR size_type npos = std::numeric_limits<size_type>::max();
+
+	/// Hints passed to madvise(), the default is sequential
+	typedef mapped_file::access_hint access_hint;
+
+	basic_mapped_string() noexcept = default;
+
+	basic_mapped_string(const Self&)            = delete;
+	basic_mapped_string& operator=(const Self&) = delete;
+
+	basic_mapped_string(Self&& s) noexcept
+		: m_file(std::move(s.m_file))
+		, m_ptr(std::exchange(s.m_ptr, nullptr))
+		, m_size(std::exchange(s.m_size, 0)) { }
+
+	basic_mapped_string& operator=(Self&& s) noexcept {
+		if(this != &s) {
+			m_file = std::move(s.m_file);
+			m_ptr  = std::exchange(s.m_ptr, nullptr);
+			m_size = std::exchange(s.m_size, 0);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief  Map the whole file at @param path
+	 * @param  hint The expected access pattern
+	 * @throw  std::system_error if the file cannot be opened or mapped
+	 * @note   A trailing partial character is ignored
+	 */
+	[[nodiscard]] static Self open(const std::filesystem::path& path, access_hint hint = access_hint::sequential) {
+		Self ret;
+		ret.m_file   = mapped_file::open(path);
+		const auto s = ret.m_file.template as_span<Char>();
+		ret.m_ptr    = s.data();
+		ret.m_size   = s.size();
+		ret.advise(hint);
+		return ret;
+	}
+
+	/**
+	 * @brief Change the expected access pattern, failures are ignored since they are only hints
+	 */
+	void advise(access_hint hint) const noexcept {
+		m_file.advise(hint);
+	}
+
+	/// Unmap the file, the string becomes empty
+	void close() noexcept {
+		m_file.close();
+		m_ptr  = nullptr;
+		m_size = 0;
+	}
+
+	bool is_open() const noexcept {
+		return m_file.is_open();
+	}
+
+	public: // Basic operations
+	DA_CONSTEXPR const_pointer data() const noexcept {
+		return m_ptr;
+	}
+
+	DA_CONSTEXPR size_type size() const noexcept {
+		return m_size;
+	}
+
+	DA_CONSTEXPR size_type length() const noexcept {
+		return m_size;
+	}
+
+	DA_CONSTEXPR size_type capacity() const noexcept {
+		return m_size;
+	}
+
+	DA_CONSTEXPR bool empty() const noexcept {
+		return m_size == 0;
+	}
+
+	public: // Iterators
+	DA_CONSTEXPR const_iterator begin() const noexcept {
+		return m_ptr;
+	}
+
+	DA_CONSTEXPR const_iterator end() const noexcept {
+		return m_ptr + m_size;
+	}
+
+	DA_CONSTEXPR const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	DA_CONSTEXPR const_iterator cend() const noexcept {
+		return end();
+	}
+
+	DA_CONSTEXPR const_reverse_iterator rbegin() const noexcept {
+		return const_reverse_iterator(end());
+	}
+
+	DA_CONSTEXPR const_reverse_iterator rend() const noexcept {
+		return const_reverse_iterator(begin());
+	}
+
+	DA_CONSTEXPR const_reverse_iterator crbegin() const noexcept {
+		return rbegin();
+	}
+
+	DA_CONSTEXPR const_reverse_iterator crend() const noexcept {
+		return rend();
+	}
+
+	public: // Member access
+	DA_CONSTEXPR const_reference operator[](size_type n) const noexcept {
+		assert(n < size());
+		return m_ptr[n];
+	}
+
+	DA_CONSTEXPR const_reference at(size_type n) const {
+		DA_IFUNLIKELY(n >= size()) {
+			DA_THROW(std::out_of_range(fmt::format("da::basic_mapped_string::at: n (which is {}) >= this->size() (which is {})", n, size())));
+		}
+		return m_ptr[n];
+	}
+
+	DA_CONSTEXPR const_reference front() const noexcept {
+		assert(!empty());
+		return m_ptr[0];
+	}
+
+	DA_CONSTEXPR const_reference back() const noexcept {
+		assert(!empty());
+		return m_ptr[m_size - 1];
+	}
+
+	public: // Others
+	DA_CONSTEXPR operator std::basic_string_view<value_type, traits_type>() const noexcept {
+		return {data(), size()};
+	}
+
+	void swap(Self& s) noexcept {
+		m_file.swap(s.m_file);
+		std::swap(m_ptr, s.m_ptr);
+		std::swap(m_size, s.m_size);
+	}
+
+	private:
+	mapped_file   m_file;
+	const_pointer m_ptr  = nullptr; // Cached from m_file
+	size_type     m_size = 0;
+};
+
+using mapped_string  = basic_mapped_string<char>;
+using mapped_wstring = basic_mapped_string<wchar_t>;
+
+DA_END_NAMESPACE
+
+#endif // DA_UNIX
+
+#endif // _DA_STRING_MAPPED_STRING_HPP_
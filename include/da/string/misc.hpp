@@ -12,6 +12,11 @@
 #define _DA_STRING_MISC_HPP_
 
 #include <da/config.hpp>
+#include <bit>         // for std::countr_zero()
+#include <type_traits> // for std::is_constant_evaluated()
+#if DA_HAS_SSE2
+	#include <emmintrin.h>
+#endif
 
 DA_BEGIN_NAMESPACE
 
@@ -25,6 +30,35 @@ DA_CONSTEXPR size_t strlen(const char* str) noexcept {
 	return ret;
 }
 
+/**
+ * @brief  Find the first occurrence of @param c in range [first, last)
+ * @return The pointer to the character found, or @param last if not found
+ * @note   Use SSE2 to compare 16 bytes at a time for byte-sized characters
+ */
+template<typename Char>
+DA_CONSTEXPR const Char* find_char(const Char* first, const Char* last, Char c) noexcept {
+	DA_ASSUME(first <= last);
+#if DA_HAS_SSE2
+	if constexpr(sizeof(Char) == 1) {
+		if(!std::is_constant_evaluated()) {
+			const __m128i pattern = _mm_set1_epi8(static_cast<char>(c));
+			while(last - first >= 16) {
+				const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+				const int     mask  = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern));
+				if(mask != 0) {
+					return first + std::countr_zero(static_cast<unsigned>(mask));
+				}
+				first += 16;
+			}
+		}
+	}
+#endif
+	while(first != last && *first != c) {
+		++first;
+	}
+	return first;
+}
+
 DA_END_NAMESPACE
 
 #endif // _DA_STRING_MISC_HPP_
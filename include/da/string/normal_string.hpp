@@ -14,6 +14,7 @@
 #include <da/config.hpp>
 #include <da/string/string_fwd.hpp>
 #include <da/string/string_traits.hpp>
+#include <da/type_traits/relocatable.hpp>
 
 DA_BEGIN_NAMESPACE
 
@@ -46,7 +47,14 @@ class normal_string_base : protected string_traits<Char, Traits, Alloc> {
 		, m_capacity(0) {
 	}
 
-	private:
+	DA_CONSTEXPR explicit normal_string_base(const allocator_type& a) noexcept
+		: string_traits_type(a)
+		, m_ptr(nullptr)
+		, m_size(0)
+		, m_capacity(0) {
+	}
+
+	protected:
 	pointer   m_ptr;
 	size_type m_size;
 	size_type m_capacity;
@@ -91,6 +99,10 @@ class normal_string_base : protected string_traits<Char, Traits, Alloc> {
 	}
 };
 
+/// The string never points to itself, so it is relocatable as long as the allocator is
+template<typename Char, typename Traits, typename Alloc>
+struct is_trivially_relocatable<normal_string_base<Char, Traits, Alloc>> : is_trivially_relocatable<Alloc> { };
+
 DA_END_NAMESPACE
 
 #endif // _DA_STRING_NORMAL_STRING_HPP_
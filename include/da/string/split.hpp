@@ -0,0 +1,279 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      split.hpp
+ * @brief     Lazy ranges to split a string into views
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_STRING_SPLIT_HPP_
+#define _DA_STRING_SPLIT_HPP_
+
+#include <da/config.hpp>
+#include <da/string/misc.hpp>
+#include <da/string/string_fwd.hpp>
+#include <ranges>
+#include <string_view>
+#include <utility> // for std::pair
+
+DA_BEGIN_DETAIL
+
+/**
+ * @brief Every delimiter used by split_view provides:
+ *        1. find(s): return {position, length} of the first delimiter in s, position is npos if not found
+ *        2. skip_trailing_empty: whether to discard the empty token after the last delimiter (or of an empty string)
+ */
+
+template<typename Char, typename Traits>
+struct char_delimiter {
+	typedef std::basic_string_view<Char, Traits> view_type;
+
+	static inline constexpr bool skip_trailing_empty = false;
+
+	Char m_char;
+
+	DA_CONSTEXPR std::pair<size_t, size_t> find(view_type s) const noexcept {
+		if constexpr(std::is_same_v<Traits, std::char_traits<Char>>) {
+			const Char* const last = s.data() + s.size();
+			const Char* const p    = find_char(s.data(), last, m_char);
+			return {p == last ? view_type::npos : static_cast<size_t>(p - s.data()), 1};
+		} else {
+			return {s.find(m_char), 1};
+		}
+	}
+};
+
+template<typename Char, typename Traits>
+struct string_delimiter {
+	typedef std::basic_string_view<Char, Traits> view_type;
+
+	static inline constexpr bool skip_trailing_empty = false;
+
+	view_type m_str;
+
+	DA_CONSTEXPR std::pair<size_t, size_t> find(view_type s) const noexcept {
+		DA_IFUNLIKELY(m_str.empty()) { // Empty delimiter never matches
+			return {view_type::npos, 0};
+		}
+		return {s.find(m_str), m_str.size()};
+	}
+};
+
+template<typename Char, typename Traits>
+struct any_delimiter {
+	typedef std::basic_string_view<Char, Traits> view_type;
+
+	static inline constexpr bool skip_trailing_empty = false;
+
+	view_type m_set;
+	uint64_t  m_table[4] = {}; // Bitmap of m_set, only used for byte-sized characters
+
+	DA_CONSTEXPR any_delimiter() noexcept = default;
+
+	DA_CONSTEXPR any_delimiter(view_type set) noexcept
+		: m_set(set) {
+		if constexpr(sizeof(Char) == 1) {
+			for(Char c : set) {
+				const auto u = static_cast<unsigned char>(c);
+				m_table[u >> 6] |= uint64_t(1) << (u & 63);
+			}
+		}
+	}
+
+	DA_CONSTEXPR std::pair<size_t, size_t> find(view_type s) const noexcept {
+		if constexpr(sizeof(Char) == 1 && std::is_same_v<Traits, std::char_traits<Char>>) {
+			for(size_t i = 0; i < s.size(); ++i) {
+				const auto u = static_cast<unsigned char>(s[i]);
+				if(m_table[u >> 6] & (uint64_t(1) << (u & 63))) {
+					return {i, 1};
+				}
+			}
+			return {view_type::npos, 1};
+		} else {
+			return {s.find_first_of(m_set), 1};
+		}
+	}
+};
+
+template<typename Char, typename Traits>
+struct line_delimiter {
+	typedef std::basic_string_view<Char, Traits> view_type;
+
+	static inline constexpr bool skip_trailing_empty = true;
+
+	DA_CONSTEXPR std::pair<size_t, size_t> find(view_type s) const noexcept {
+		auto [pos, len] = char_delimiter<Char, Traits>{Char('\n')}.find(s);
+		if(pos != view_type::npos && pos != 0 && Traits::eq(s[pos - 1], Char('\r'))) {
+			return {pos - 1, 2};
+		}
+		return {pos, len};
+	}
+};
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief A forward range yields the tokens of a string separated by Delimiter
+ * @note  Tokens are views into the origin string, so the string must outlive the range
+ * @note  Nothing is allocated, the next token is searched only when the iterator is incremented
+ */
+template<typename Char, typename Traits, typename Delimiter>
+class split_view : public std::ranges::view_interface<split_view<Char, Traits, Delimiter>> {
+	public:
+	typedef std::basic_string_view<Char, Traits> view_type;
+
+	class iterator {
+		public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef view_type                 value_type;
+		typedef std::ptrdiff_t            difference_type;
+		typedef const view_type*          pointer;
+		typedef const view_type&          reference;
+
+		DA_CONSTEXPR iterator() noexcept = default;
+
+		DA_CONSTEXPR iterator(view_type s, const Delimiter* d) noexcept
+			: m_delim(d)
+			, m_rest(s) {
+			if(Delimiter::skip_trailing_empty && s.empty()) {
+				m_done = true;
+			} else {
+				_M_next();
+			}
+		}
+
+		DA_CONSTEXPR reference operator*() const noexcept {
+			return m_token;
+		}
+
+		DA_CONSTEXPR pointer operator->() const noexcept {
+			return &m_token;
+		}
+
+		DA_CONSTEXPR iterator& operator++() noexcept {
+			return (_M_next(), *this);
+		}
+
+		DA_CONSTEXPR iterator operator++(int) noexcept {
+			iterator tmp = *this;
+			_M_next();
+			return tmp;
+		}
+
+		DA_CONSTEXPR bool operator==(const iterator& other) const noexcept {
+			return m_done == other.m_done && (m_done || (m_token.data() == other.m_token.data() && m_last == other.m_last));
+		}
+
+		DA_CONSTEXPR bool operator==(std::default_sentinel_t) const noexcept {
+			return m_done;
+		}
+
+		private:
+		DA_CONSTEXPR void _M_next() noexcept {
+			if(m_last) {
+				m_done = true;
+				return;
+			}
+			const auto [pos, len] = m_delim->find(m_rest);
+			if(pos == view_type::npos) {
+				m_token = m_rest;
+				m_rest.remove_prefix(m_rest.size());
+				m_last = true;
+				return;
+			}
+			m_token = m_rest.substr(0, pos);
+			m_rest.remove_prefix(pos + len);
+			if(Delimiter::skip_trailing_empty && m_rest.empty()) {
+				m_last = true;
+			}
+		}
+
+		const Delimiter* m_delim = nullptr;
+		view_type        m_rest;
+		view_type        m_token;
+		bool             m_last = false; // m_token is the last token
+		bool             m_done = false; // Reached the end
+	};
+
+	DA_CONSTEXPR split_view() noexcept = default;
+
+	DA_CONSTEXPR split_view(view_type s, Delimiter d) noexcept
+		: m_str(s)
+		, m_delim(d) { }
+
+	DA_CONSTEXPR iterator begin() const noexcept {
+		return iterator(m_str, &m_delim);
+	}
+
+	DA_CONSTEXPR std::default_sentinel_t end() const noexcept {
+		return {};
+	}
+
+	DA_CONSTEXPR view_type base() const noexcept {
+		return m_str;
+	}
+
+	private:
+	view_type m_str;
+	Delimiter m_delim{};
+};
+
+/// Any string type with value_type & traits_type, e.g. std::string, std::string_view, da::string
+template<typename String>
+using string_view_of = std::basic_string_view<typename std::remove_cvref_t<String>::value_type,
+											  typename std::remove_cvref_t<String>::traits_type>;
+
+/// Refuse temporary strings, otherwise the views will dangle
+template<typename String>
+concept splittable_string = std::convertible_to<const std::remove_cvref_t<String>&, string_view_of<String>>
+	&& (std::is_lvalue_reference_v<String> || std::ranges::borrowed_range<std::remove_cvref_t<String>>);
+
+/**
+ * @brief Split @param s by the character @param d, e.g. "a,,b" -> ["a", "", "b"]
+ */
+template<splittable_string String>
+[[nodiscard]] DA_CONSTEXPR auto split(String&& s, typename string_view_of<String>::value_type d) noexcept {
+	typedef string_view_of<String> view_type;
+	typedef _DA_DETAIL char_delimiter<typename view_type::value_type, typename view_type::traits_type> delimiter_type;
+	return split_view<typename view_type::value_type, typename view_type::traits_type, delimiter_type>(view_type(s), delimiter_type{d});
+}
+
+/**
+ * @brief Split @param s by the string @param d, an empty @param d never matches
+ */
+template<splittable_string String>
+[[nodiscard]] DA_CONSTEXPR auto split(String&& s, string_view_of<String> d) noexcept {
+	typedef string_view_of<String> view_type;
+	typedef _DA_DETAIL string_delimiter<typename view_type::value_type, typename view_type::traits_type> delimiter_type;
+	return split_view<typename view_type::value_type, typename view_type::traits_type, delimiter_type>(view_type(s), delimiter_type{d});
+}
+
+/**
+ * @brief Split @param s by any character in @param set
+ */
+template<splittable_string String>
+[[nodiscard]] DA_CONSTEXPR auto split_any(String&& s, string_view_of<String> set) noexcept {
+	typedef string_view_of<String> view_type;
+	typedef _DA_DETAIL any_delimiter<typename view_type::value_type, typename view_type::traits_type> delimiter_type;
+	return split_view<typename view_type::value_type, typename view_type::traits_type, delimiter_type>(view_type(s), delimiter_type(set));
+}
+
+/**
+ * @brief Split @param s into lines ended by "\n" or "\r\n"
+ * @note  Like python's splitlines(), the empty line after the last line break is discarded,
+ *        and an empty string contains no line
+ */
+template<splittable_string String>
+[[nodiscard]] DA_CONSTEXPR auto split_lines(String&& s) noexcept {
+	typedef string_view_of<String> view_type;
+	typedef _DA_DETAIL line_delimiter<typename view_type::value_type, typename view_type::traits_type> delimiter_type;
+	return split_view<typename view_type::value_type, typename view_type::traits_type, delimiter_type>(view_type(s), delimiter_type{});
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_STRING_SPLIT_HPP_
@@ -14,6 +14,7 @@
 #include <da/config.hpp>
 #include <da/string/string_fwd.hpp>
 #include <da/string/string_traits.hpp>
+#include <da/type_traits/relocatable.hpp>
 
 DA_BEGIN_NAMESPACE
 
@@ -46,24 +47,30 @@ class sso_string_base : protected string_traits<Char, Traits, Alloc> {
 
 	// 2 represents alignment & '\0'
 	static inline DA_CONSTEXPR size_type max_sso_size = ((2 * sizeof(size_type) + sizeof(pointer)) / sizeof(value_type)) - 2;
-	// Since the highest bit of m_size is used to identify whether it is optimized,
+	// Since the lowest bit of m_size is used to identify whether it is optimized,
 	// we can only use half of the size
 	static inline DA_CONSTEXPR size_type npos = std::numeric_limits<size_type>::max() / 2;
 
 	DA_CONSTEXPR sso_string_base() noexcept
-		: m_data{.short_string = {0x80, {'\0'}}} { }
+		: m_data{.short_string = {0x01, {'\0'}}} { }
+
+	DA_CONSTEXPR explicit sso_string_base(const allocator_type& a) noexcept
+		: string_traits_type(a)
+		, m_data{.short_string = {0x01, {'\0'}}} { }
 
 	private:
 	// The memory layout is like:
 	// SSO:
 	// ---------------------------------
-	// |S&m_size| 1B                   | 8B
+	// |m_size&S| 1B                   | 8B
 	// |             m_ptr             | 16B
 	// |                               | 24B
 	// Normal:
-	// | S | 1b      m_size            | 8B
+	// |        m_size         |   S   | 8B
 	// |             m_capacity        | 16B
 	// |             m_ptr             | 24B
+	// S is the lowest bit of the first byte, and m_size is stored shifted by 1 in both states,
+	// so S is 0 for a normal string on little-endian, and on big-endian as long as the size is below 2^55
 	// If S is 1, then the string is optimized
 	// otherwise, it is in normal state;
 	union data_type {
@@ -81,7 +88,7 @@ class sso_string_base : protected string_traits<Char, Traits, Alloc> {
 	protected: // Internal functions used by da::string
 	// Check whether the string is optimized
 	DA_CONSTEXPR bool is_sso() const noexcept {
-		return (*reinterpret_cast<const uint8_t* const>(&m_data)) & (0x80);
+		return (*reinterpret_cast<const uint8_t* const>(&m_data)) & (0x01);
 	}
 
 	DA_CONSTEXPR void change_sso_to_normal() {
@@ -157,8 +164,8 @@ class sso_string_base : protected string_traits<Char, Traits, Alloc> {
 
 	public: // Basic operations
 	DA_CONSTEXPR size_type size() const noexcept {
-		return is_sso() ? static_cast<size_type>(m_data.short_string.m_size - 0x80) // SSO bit
-						: m_data.long_string.m_size;
+		return is_sso() ? static_cast<size_type>(m_data.short_string.m_size >> 1) // SSO bit
+						: m_data.long_string.m_size >> 1;
 	}
 
 	DA_CONSTEXPR size_type capacity() const noexcept {
@@ -178,9 +185,9 @@ class sso_string_base : protected string_traits<Char, Traits, Alloc> {
 	DA_CONSTEXPR void _M_size(size_type n) noexcept {
 		assert(n <= capacity());
 		if(is_sso()) {
-			m_data.short_string.m_size = static_cast<uint8_t>(n + 0x80);
+			m_data.short_string.m_size = static_cast<uint8_t>(n << 1 | 1);
 		} else {
-			m_data.long_string.m_size = n;
+			m_data.long_string.m_size = n << 1;
 		}
 		_S_assign(data()[n], Char());
 	}
@@ -204,7 +211,7 @@ class sso_string_base : protected string_traits<Char, Traits, Alloc> {
 				data_type new_data{};
 				new_data.long_string.m_ptr      = p;
 				new_data.long_string.m_capacity = capacity();
-				new_data.long_string.m_size     = size();
+				new_data.long_string.m_size     = size() << 1;
 				m_data                          = new_data;
 			}
 		}
@@ -228,11 +235,15 @@ class sso_string_base : protected string_traits<Char, Traits, Alloc> {
 		}
 	}
 
-	DA_CONSTEXPR void swap(const Self& s) {
+	DA_CONSTEXPR void swap(Self& s) noexcept {
 		std::swap(m_data, s.m_data);
 	}
 };
 
+/// The short string is located from this on every access instead of storing a pointer to itself
+template<typename Char, typename Traits, typename Alloc>
+struct is_trivially_relocatable<sso_string_base<Char, Traits, Alloc>> : is_trivially_relocatable<Alloc> { };
+
 DA_END_NAMESPACE
 
 #endif // _DA_STRING_SSO_STRING_HPP_
@@ -32,19 +32,33 @@ class cow_string_base;
 template<typename Char, typename Traits = std::char_traits<Char>, typename Alloc = std::allocator<Char>>
 class normal_string_base;
 
+template<typename Char, typename Traits = std::char_traits<Char>, typename Alloc = std::allocator<Char>>
+class lazy_string_base;
+
 template<typename Char, typename Traits, typename Alloc,
 		 template<typename, typename, typename> typename StringImpl>
 class string_base;
 
+template<typename T, size_t N>
+class stack_allocator;
+
 template<typename Char, template<typename, typename, typename> typename StringImpl = normal_string_base>
 using string_base_helper = string_base<Char, std::char_traits<Char>, std::allocator<Char>, StringImpl>;
 
-using string      = string_base_helper<char>;
-using wstring     = string_base_helper<wchar_t>;
-using sso_string  = string_base_helper<char, sso_string_base>;
-using sso_wstring = string_base_helper<wchar_t, sso_string_base>;
-using cow_string  = string_base_helper<char, cow_string_base>;
-using cow_wstring = string_base_helper<wchar_t, cow_string_base>;
+using string       = string_base_helper<char>;
+using wstring      = string_base_helper<wchar_t>;
+using sso_string   = string_base_helper<char, sso_string_base>;
+using sso_wstring  = string_base_helper<wchar_t, sso_string_base>;
+using cow_string   = string_base_helper<char, cow_string_base>;
+using cow_wstring  = string_base_helper<wchar_t, cow_string_base>;
+using lazy_string  = string_base_helper<char, lazy_string_base>;
+using lazy_wstring = string_base_helper<wchar_t, lazy_string_base>;
+
+/// Strings allocating from a stack_buffer<N> first, e.g. `stack_buffer<256> buf; stack_string<256> s(buf);`
+template<size_t N>
+using stack_string = string_base<char, std::char_traits<char>, stack_allocator<char, N>, sso_string_base>;
+template<size_t N>
+using stack_wstring = string_base<wchar_t, std::char_traits<wchar_t>, stack_allocator<wchar_t, N>, sso_string_base>;
 
 DA_END_NAMESPACE
 
@@ -26,6 +26,11 @@ class string_traits : protected Alloc { // Empty-Base Optimization
 	typedef value_type&                reference;
 	typedef const value_type&          const_reference;
 
+	string_traits() = default;
+
+	DA_CONSTEXPR explicit string_traits(const Alloc& a) noexcept
+		: Alloc(a) { }
+
 	operator Alloc() {
 		return *static_cast<Alloc*>(this);
 	}
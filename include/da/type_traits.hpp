@@ -13,6 +13,7 @@
 
 #include <da/type_traits/config.hpp>
 #include <da/type_traits/function_detect.hpp>
+#include <da/type_traits/relocatable.hpp>
 #include <da/type_traits/sequence.hpp>
 #include <da/type_traits/typelist.hpp>
 
@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      relocatable.hpp
+ * @brief     Detect types which can be moved by memcpy
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_TYPE_TRAITS_RELOCATABLE_HPP_
+#define _DA_TYPE_TRAITS_RELOCATABLE_HPP_
+
+#include <da/type_traits/config.hpp>
+#include <memory> // for std::allocator
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief Whether moving an object of T to a new address then destroying the old one
+ *        is equivalent to copying its bytes and forgetting the old one
+ * @note  Specialize it for types which own resources but never point to themselves,
+ *        e.g. da::string. Containers use it to relocate elements by memcpy
+ */
+template<typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> { };
+
+template<typename T>
+struct is_trivially_relocatable<const T> : is_trivially_relocatable<T> { };
+
+template<typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type { };
+
+template<typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+DA_END_NAMESPACE
+
+#endif // _DA_TYPE_TRAITS_RELOCATABLE_HPP_
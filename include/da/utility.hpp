@@ -11,6 +11,9 @@
 #ifndef _DA_UTILITY_HPP_
 #define _DA_UTILITY_HPP_
 
+#include <da/utility/batch.hpp>
+#include <da/utility/charconv.hpp>
+#include <da/utility/fixed_point_math.hpp>
 #include <da/utility/hash.hpp>
 #include <da/utility/math.hpp>
 #include <da/utility/number.hpp>
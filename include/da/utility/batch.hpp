@@ -0,0 +1,416 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      batch.hpp
+ * @brief     Arithmetic over spans of fixed_point
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_UTILITY_BATCH_HPP_
+#define _DA_UTILITY_BATCH_HPP_
+
+#include <da/config.hpp>
+#include <da/concepts.hpp>
+#include <da/format.hpp>
+#include <da/utility/math.hpp>
+#include <da/utility/number.hpp>
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <utility> // for std::in_range()
+#if DA_HAS_AVX2 || DA_HAS_AVX512
+	#include <immintrin.h>
+#endif
+
+DA_BEGIN_DETAIL
+
+/// @tparam T is fixed_point<P, B> or const fixed_point<P, B>
+template<typename T, typename F>
+concept span_element_of = std::is_same_v<std::remove_const_t<T>, F>;
+
+template<typename T>
+struct fixed_point_traits : std::false_type { };
+
+template<size_t P, arithmetic B>
+struct fixed_point_traits<fixed_point<P, B>> : std::true_type {
+	typedef B base_type;
+
+	static inline constexpr size_t precision = P;
+};
+
+/// The SIMD paths are only written for int64_t, smaller Base is left to the auto-vectorizer
+template<typename B>
+inline constexpr bool use_simd = (DA_HAS_AVX2 || DA_HAS_AVX512) && std::is_same_v<B, int64_t>;
+
+template<size_t P, typename B>
+const B* raw_data(const fixed_point<P, B>* p) noexcept {
+	static_assert(sizeof(fixed_point<P, B>) == sizeof(B), "fixed_point should have the same layout as its Base");
+	return reinterpret_cast<const B*>(p);
+}
+
+template<size_t P, typename B>
+B* raw_data(fixed_point<P, B>* p) noexcept {
+	return reinterpret_cast<B*>(p);
+}
+
+/**
+ * @brief A 128-bit two's complement accumulator, which never overflows for less than 2^64 additions
+ */
+struct wide_sum {
+	uint64_t lo = 0;
+	uint64_t hi = 0;
+
+	template<integral T>
+	DA_CONSTEXPR void add(T x) noexcept {
+		const uint64_t l = lo + static_cast<uint64_t>(x);
+		hi += (x < 0 ? ~uint64_t(0) : 0) + (l < lo); // Sign extension & carry
+		lo = l;
+	}
+
+	/// Add @param n copies of @param x
+	template<integral T>
+	DA_CONSTEXPR void add(T x, uint64_t n) noexcept {
+		const uint64_t u = x < 0 ? uint64_t(0) - static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+		u128           p = umul128(u, n);
+		if(x < 0) { // Two's complement of the 128-bit product
+			p = u128_sub({0, 0}, p);
+		}
+		const uint64_t l = lo + p.lo;
+		hi += p.hi + (l < lo);
+		lo = l;
+	}
+
+	/// Whether the sum fits in @tparam T, and store it to @param out if so
+	template<integral T>
+	[[nodiscard]] DA_CONSTEXPR bool get(T& out) const noexcept {
+		if constexpr(std::is_signed_v<T>) {
+			const auto v = static_cast<int64_t>(lo);
+			DA_IFUNLIKELY(hi != (v < 0 ? ~uint64_t(0) : 0) || !std::in_range<T>(v)) {
+				return false;
+			}
+			out = static_cast<T>(v);
+		} else {
+			DA_IFUNLIKELY(hi != 0 || !std::in_range<T>(lo)) {
+				return false;
+			}
+			out = static_cast<T>(lo);
+		}
+		return true;
+	}
+};
+
+#if DA_HAS_AVX2 || DA_HAS_AVX512
+/**
+ * @brief Sum @param n values exactly with SIMD, where @param n < 2^32
+ * @note  x = high * 2^32 + low - sign * 2^64, where high & low are the unsigned halves of x,
+ *        so three 64-bit lanes accumulate them without any carry
+ */
+inline wide_sum simd_sum(const int64_t* p, size_t n) noexcept {
+	DA_ASSERT(n < (size_t(1) << 32));
+	uint64_t lo = 0, hi = 0, neg = 0;
+	size_t   i  = 0;
+	#if DA_HAS_AVX512
+	{
+		const __m512i mask = _mm512_set1_epi64(0xFFFFFFFF);
+		__m512i       l    = _mm512_setzero_si512();
+		__m512i       h    = _mm512_setzero_si512();
+		__m512i       s    = _mm512_setzero_si512();
+		for(; i + 8 <= n; i += 8) {
+			const __m512i x = _mm512_loadu_si512(p + i);
+			l               = _mm512_add_epi64(l, _mm512_and_si512(x, mask));
+			h               = _mm512_add_epi64(h, _mm512_srli_epi64(x, 32));
+			s               = _mm512_add_epi64(s, _mm512_srli_epi64(x, 63));
+		}
+		lo += static_cast<uint64_t>(_mm512_reduce_add_epi64(l));
+		hi += static_cast<uint64_t>(_mm512_reduce_add_epi64(h));
+		neg += static_cast<uint64_t>(_mm512_reduce_add_epi64(s));
+	}
+	#endif
+	#if DA_HAS_AVX2
+	{
+		const __m256i mask = _mm256_set1_epi64x(0xFFFFFFFF);
+		__m256i       l    = _mm256_setzero_si256();
+		__m256i       h    = _mm256_setzero_si256();
+		__m256i       s    = _mm256_setzero_si256();
+		for(; i + 4 <= n; i += 4) {
+			const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			l               = _mm256_add_epi64(l, _mm256_and_si256(x, mask));
+			h               = _mm256_add_epi64(h, _mm256_srli_epi64(x, 32));
+			s               = _mm256_add_epi64(s, _mm256_srli_epi64(x, 63));
+		}
+		alignas(32) uint64_t t[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(t), l);
+		lo += t[0] + t[1] + t[2] + t[3];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(t), h);
+		hi += t[0] + t[1] + t[2] + t[3];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(t), s);
+		neg += t[0] + t[1] + t[2] + t[3];
+	}
+	#endif
+	for(; i < n; ++i) {
+		const auto x = static_cast<uint64_t>(p[i]);
+		lo += x & 0xFFFFFFFF;
+		hi += x >> 32;
+		neg += x >> 63;
+	}
+	wide_sum r{hi << 32, hi >> 32};
+	r.add(lo);
+	r.hi -= neg;
+	return r;
+}
+
+/// The minimum or maximum of @param n > 0 values
+template<bool Max>
+inline int64_t simd_minmax(const int64_t* p, size_t n) noexcept {
+	DA_ASSERT(n > 0);
+	int64_t m = p[0];
+	size_t  i = 0;
+	#if DA_HAS_AVX512
+	if(n >= 8) {
+		__m512i v = _mm512_loadu_si512(p);
+		for(i = 8; i + 8 <= n; i += 8) {
+			const __m512i x = _mm512_loadu_si512(p + i);
+			v               = Max ? _mm512_max_epi64(v, x) : _mm512_min_epi64(v, x);
+		}
+		m = Max ? _mm512_reduce_max_epi64(v) : _mm512_reduce_min_epi64(v);
+	}
+	#endif
+	#if DA_HAS_AVX2
+	if(n - i >= 4) {
+		__m256i v = _mm256_set1_epi64x(m);
+		for(; i + 4 <= n; i += 4) {
+			const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			// Take x where v > x for min, or x > v for max
+			v = _mm256_blendv_epi8(v, x, Max ? _mm256_cmpgt_epi64(x, v) : _mm256_cmpgt_epi64(v, x));
+		}
+		alignas(32) int64_t t[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(t), v);
+		for(int64_t x : t) {
+			m = Max ? std::max(m, x) : std::min(m, x);
+		}
+	}
+	#endif
+	for(; i < n; ++i) {
+		m = Max ? std::max(m, p[i]) : std::min(m, p[i]);
+	}
+	return m;
+}
+
+inline void simd_add(const int64_t* a, const int64_t* b, int64_t* out, size_t n) noexcept {
+	size_t i = 0;
+	#if DA_HAS_AVX512
+	for(; i + 8 <= n; i += 8) {
+		_mm512_storeu_si512(out + i, _mm512_add_epi64(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)));
+	}
+	#endif
+	#if DA_HAS_AVX2
+	for(; i + 4 <= n; i += 4) {
+		const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(x, y));
+	}
+	#endif
+	for(; i < n; ++i) {
+		out[i] = static_cast<int64_t>(static_cast<uint64_t>(a[i]) + static_cast<uint64_t>(b[i]));
+	}
+}
+
+/**
+ * @brief out[i] = in[i] * k, wrapped like the scalar multiplication
+ * @note  AVX2 has no 64-bit multiplication, so k must be less than 2^32 and
+ *        x * k = low(x) * k + (high(x) * k << 32) (mod 2^64)
+ */
+inline void simd_scale(const int64_t* in, int64_t* out, size_t n, uint64_t k) noexcept {
+	size_t i = 0;
+	#if DA_HAS_AVX512
+	{
+		const __m512i kv = _mm512_set1_epi64(static_cast<int64_t>(k));
+		for(; i + 8 <= n; i += 8) {
+			_mm512_storeu_si512(out + i, _mm512_mullo_epi64(_mm512_loadu_si512(in + i), kv));
+		}
+	}
+	#endif
+	#if DA_HAS_AVX2
+	if(k >> 32 == 0) {
+		const __m256i kv = _mm256_set1_epi64x(static_cast<int64_t>(k));
+		for(; i + 4 <= n; i += 4) {
+			const __m256i x  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+			const __m256i lo = _mm256_mul_epu32(x, kv);
+			const __m256i hi = _mm256_slli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), kv), 32);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(lo, hi));
+		}
+	}
+	#endif
+	for(; i < n; ++i) {
+		out[i] = static_cast<int64_t>(static_cast<uint64_t>(in[i]) * k);
+	}
+}
+#endif // DA_HAS_AVX2 || DA_HAS_AVX512
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief out[i] = a[i] + b[i]
+ * @note  @param out may be the same as @param a or @param b
+ */
+template<size_t P, arithmetic B, size_t E, _DA_DETAIL span_element_of<fixed_point<P, B>> T1, size_t E1, _DA_DETAIL span_element_of<fixed_point<P, B>> T2, size_t E2>
+void add(std::span<T1, E1> a, std::span<T2, E2> b, std::span<fixed_point<P, B>, E> out) noexcept {
+	DA_ASSERT(a.size() == out.size() && b.size() == out.size());
+#if DA_HAS_AVX2 || DA_HAS_AVX512
+	if constexpr(_DA_DETAIL use_simd<B>) {
+		_DA_DETAIL simd_add(_DA_DETAIL raw_data(a.data()), _DA_DETAIL raw_data(b.data()), _DA_DETAIL raw_data(out.data()), out.size());
+		return;
+	}
+#endif
+	for(size_t i = 0; i < out.size(); ++i) {
+		out[i] = a[i] + b[i];
+	}
+}
+
+/**
+ * @brief out[i] = a[i] * b[i]
+ * @note  There is no SIMD path since neither AVX2 nor AVX-512 has the 64 x 64 -> 128 bits multiplication
+ *        needed to match operator*, which is exact for integral Base
+ */
+template<size_t P, arithmetic B, size_t E, _DA_DETAIL span_element_of<fixed_point<P, B>> T1, size_t E1, _DA_DETAIL span_element_of<fixed_point<P, B>> T2, size_t E2>
+void multiply(std::span<T1, E1> a, std::span<T2, E2> b, std::span<fixed_point<P, B>, E> out) noexcept {
+	DA_ASSERT(a.size() == out.size() && b.size() == out.size());
+	for(size_t i = 0; i < out.size(); ++i) {
+		out[i] = a[i] * b[i];
+	}
+}
+
+/**
+ * @brief out[i] = a[i] * b[i] + c[i], the product is rounded before the addition like the scalar operators
+ */
+template<size_t P, arithmetic B, size_t E, _DA_DETAIL span_element_of<fixed_point<P, B>> T1, size_t E1, _DA_DETAIL span_element_of<fixed_point<P, B>> T2, size_t E2, _DA_DETAIL span_element_of<fixed_point<P, B>> T3, size_t E3>
+void fma(std::span<T1, E1> a, std::span<T2, E2> b, std::span<T3, E3> c, std::span<fixed_point<P, B>, E> out) noexcept {
+	DA_ASSERT(a.size() == out.size() && b.size() == out.size() && c.size() == out.size());
+	for(size_t i = 0; i < out.size(); ++i) {
+		out[i] = a[i] * b[i] + c[i];
+	}
+}
+
+/**
+ * @brief  out[i] = in[i], converted to the precision of @param out like the converting constructor
+ */
+template<size_t P, arithmetic B, size_t E, typename T, size_t E1>
+	requires _DA_DETAIL fixed_point_traits<std::remove_const_t<T>>::value
+void rescale(std::span<T, E1> in, std::span<fixed_point<P, B>, E> out) noexcept {
+	DA_ASSERT(in.size() == out.size());
+#if DA_HAS_AVX2 || DA_HAS_AVX512
+	typedef _DA_DETAIL fixed_point_traits<std::remove_const_t<T>> from;
+	if constexpr(_DA_DETAIL use_simd<B> && _DA_DETAIL use_simd<typename from::base_type> && P >= from::precision) {
+		_DA_DETAIL simd_scale(_DA_DETAIL raw_data(in.data()), _DA_DETAIL raw_data(out.data()), out.size(), _DA_DETAIL fixed_point_arith<B, P - from::precision>::D);
+		return;
+	}
+#endif
+	for(size_t i = 0; i < out.size(); ++i) {
+		out[i] = fixed_point<P, B>(in[i]);
+	}
+}
+
+/**
+ * @brief  The sum of @param a, accumulated in 128 bits for integral Base so that it never overflows in the middle
+ * @throw  std::overflow_error if the sum doesn't fit in the Base
+ */
+template<typename T, size_t E>
+	requires _DA_DETAIL fixed_point_traits<std::remove_const_t<T>>::value
+[[nodiscard]] std::remove_const_t<T> sum(std::span<T, E> a) {
+	typedef std::remove_const_t<T>                               F;
+	typedef typename _DA_DETAIL fixed_point_traits<F>::base_type Base;
+	if constexpr(std::is_integral_v<Base>) {
+		_DA_DETAIL wide_sum s;
+#if DA_HAS_AVX2 || DA_HAS_AVX512
+		if constexpr(_DA_DETAIL use_simd<Base>) {
+			constexpr size_t block = size_t(1) << 31;
+			for(size_t i = 0; i < a.size(); i += block) {
+				const auto part = _DA_DETAIL simd_sum(_DA_DETAIL raw_data(a.data()) + i, std::min(block, a.size() - i));
+				s.add(part.lo);
+				s.hi += part.hi;
+			}
+		} else
+#endif
+		{
+			for(const F& x : a) {
+				s.add(x.raw());
+			}
+		}
+		Base r{};
+		DA_IFUNLIKELY(!s.get(r)) {
+			DA_THROW(std::overflow_error("da::sum: The sum doesn't fit in the Base type"));
+		}
+		return F::from_raw(r);
+	} else {
+		F r;
+		for(const F& x : a) {
+			r += x;
+		}
+		return r;
+	}
+}
+
+/**
+ * @brief  The sum of a[i] * b[i], each product is rounded like operator* and then accumulated like sum()
+ * @throw  std::overflow_error if the sum doesn't fit in the Base
+ */
+template<typename T1, size_t E1, _DA_DETAIL span_element_of<std::remove_const_t<T1>> T2, size_t E2>
+	requires _DA_DETAIL fixed_point_traits<std::remove_const_t<T1>>::value
+[[nodiscard]] std::remove_const_t<T1> dot(std::span<T1, E1> a, std::span<T2, E2> b) {
+	typedef std::remove_const_t<T1>                              F;
+	typedef typename _DA_DETAIL fixed_point_traits<F>::base_type Base;
+	DA_ASSERT(a.size() == b.size());
+	if constexpr(std::is_integral_v<Base>) {
+		_DA_DETAIL wide_sum s;
+		for(size_t i = 0; i < a.size(); ++i) {
+			s.add((a[i] * b[i]).raw());
+		}
+		Base r{};
+		DA_IFUNLIKELY(!s.get(r)) {
+			DA_THROW(std::overflow_error("da::dot: The sum doesn't fit in the Base type"));
+		}
+		return F::from_raw(r);
+	} else {
+		F r;
+		for(size_t i = 0; i < a.size(); ++i) {
+			r += a[i] * b[i];
+		}
+		return r;
+	}
+}
+
+/// The minimum of @param a, which must not be empty
+template<typename T, size_t E>
+	requires _DA_DETAIL fixed_point_traits<std::remove_const_t<T>>::value
+[[nodiscard]] std::remove_const_t<T> min(std::span<T, E> a) noexcept {
+	DA_ASSERT(!a.empty());
+#if DA_HAS_AVX2 || DA_HAS_AVX512
+	typedef std::remove_const_t<T> F;
+	if constexpr(_DA_DETAIL use_simd<typename _DA_DETAIL fixed_point_traits<F>::base_type>) {
+		return F::from_raw(_DA_DETAIL simd_minmax<false>(_DA_DETAIL raw_data(a.data()), a.size()));
+	}
+#endif
+	return *std::min_element(a.begin(), a.end());
+}
+
+/// The maximum of @param a, which must not be empty
+template<typename T, size_t E>
+	requires _DA_DETAIL fixed_point_traits<std::remove_const_t<T>>::value
+[[nodiscard]] std::remove_const_t<T> max(std::span<T, E> a) noexcept {
+	DA_ASSERT(!a.empty());
+#if DA_HAS_AVX2 || DA_HAS_AVX512
+	typedef std::remove_const_t<T> F;
+	if constexpr(_DA_DETAIL use_simd<typename _DA_DETAIL fixed_point_traits<F>::base_type>) {
+		return F::from_raw(_DA_DETAIL simd_minmax<true>(_DA_DETAIL raw_data(a.data()), a.size()));
+	}
+#endif
+	return *std::max_element(a.begin(), a.end());
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_UTILITY_BATCH_HPP_
@@ -0,0 +1,210 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      charconv.hpp
+ * @brief     Convert between numbers and decimal characters
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_UTILITY_CHARCONV_HPP_
+#define _DA_UTILITY_CHARCONV_HPP_
+
+#include <da/config.hpp>
+#include <da/utility/math.hpp>
+#include <array>
+#include <bit>
+#include <charconv> // for std::to_chars_result & std::from_chars_result, and floating point
+#include <cstring>  // for std::memcpy
+#include <limits>
+#include <system_error>
+
+DA_BEGIN_DETAIL
+
+/// "00", "01", ..., "99", so that two digits are written per step
+inline constexpr std::array<char, 200> digits2 = [] {
+	std::array<char, 200> t{};
+	for(int i = 0; i < 100; ++i) {
+		t[2 * i]     = static_cast<char>('0' + i / 10);
+		t[2 * i + 1] = static_cast<char>('0' + i % 10);
+	}
+	return t;
+}();
+
+/// Number of decimal digits of @param n, 1 for 0
+[[nodiscard]] DA_CONSTEXPR int count_digits(uint64_t n) noexcept {
+	return ilog10(n | 1) + 1;
+}
+
+DA_CONSTEXPR void copy2(char* dest, uint64_t n) noexcept {
+	DA_ASSERT(n < 100);
+	dest[0] = digits2[n * 2];
+	dest[1] = digits2[n * 2 + 1];
+}
+
+/**
+ * @brief  Write @param n backward so that the last digit is at end[-1]
+ * @return The first digit written
+ */
+DA_CONSTEXPR char* write_digits_backward(char* end, uint64_t n) noexcept {
+	while(n >= 100) {
+		end -= 2;
+		copy2(end, n % 100);
+		n /= 100;
+	}
+	if(n >= 10) {
+		end -= 2;
+		copy2(end, n);
+	} else {
+		*--end = static_cast<char>('0' + n);
+	}
+	return end;
+}
+
+/**
+ * @brief Write exactly @param count digits of @param n backward, padded by leading '0'
+ */
+DA_CONSTEXPR void write_fixed_digits_backward(char* end, uint64_t n, int count) noexcept {
+	DA_ASSERT(count >= count_digits(n) || (n == 0 && count == 0));
+	for(; count >= 2; count -= 2) {
+		end -= 2;
+		copy2(end, n % 100);
+		n /= 100;
+	}
+	if(count == 1) {
+		*--end = static_cast<char>('0' + n);
+	}
+}
+
+DA_CONSTEXPR bool is_digit(char c) noexcept {
+	return static_cast<unsigned char>(c - '0') < 10;
+}
+
+/// Load 8 characters as a little-endian integer
+DA_CONSTEXPR uint64_t load8(const char* p) noexcept {
+	if(!std::is_constant_evaluated() && std::endian::native == std::endian::little) {
+		uint64_t v;
+		std::memcpy(&v, p, 8);
+		return v;
+	}
+	uint64_t v = 0;
+	for(int i = 7; i >= 0; --i) {
+		v = (v << 8) | static_cast<unsigned char>(p[i]);
+	}
+	return v;
+}
+
+/// Whether all the 8 characters packed in @param v are digits, from simdjson & fast_float
+DA_CONSTEXPR bool is_eight_digits(uint64_t v) noexcept {
+	return ((v & 0xF0F0F0F0F0F0F0F0) | (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+/// The value of the 8 digits packed in @param v, with 3 multiplications instead of 8
+DA_CONSTEXPR uint32_t parse_eight_digits(uint64_t v) noexcept {
+	v -= 0x3030303030303030;
+	v = v * 10 + (v >> 8); // Each 16-bit lane holds 2 digits in its low byte
+	v = (((v & 0x000000FF000000FF) * 0x000F424000000064) + (((v >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >> 32;
+	return static_cast<uint32_t>(v);
+}
+
+/**
+ * @brief  Parse the digits from @param p into @param value, 8 digits at a time
+ * @note   All the digits are consumed even if the value overflows
+ * @return Whether the value fits in 64 bits
+ */
+DA_CONSTEXPR bool parse_digits(const char*& p, const char* last, uint64_t& value) noexcept {
+	bool     ok = true;
+	uint64_t v  = value;
+	while(last - p >= 8) {
+		const uint64_t chunk = load8(p);
+		if(!is_eight_digits(chunk)) {
+			break;
+		}
+		ok &= checked_mul(v, uint64_t(100000000), v);
+		ok &= checked_add(v, uint64_t(parse_eight_digits(chunk)), v);
+		p += 8;
+	}
+	for(; p != last && is_digit(*p); ++p) {
+		ok &= checked_mul(v, uint64_t(10), v);
+		ok &= checked_add(v, static_cast<uint64_t>(*p - '0'), v);
+	}
+	value = v;
+	return ok;
+}
+
+template<typename T>
+concept char_convertible_integral = integral<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief  Write @param value in decimal, which is the same as std::to_chars(first, last, value)
+ * @note   The digits are counted first by ilog10(), so that they are written backward in pairs into place
+ * @return Like std::to_chars, {last, std::errc::value_too_large} if there is not enough space
+ */
+template<_DA_DETAIL char_convertible_integral T>
+DA_CONSTEXPR std::to_chars_result to_chars(char* first, char* last, T value) noexcept {
+	const bool     negative = value < 0;
+	const uint64_t u        = negative ? uint64_t(0) - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+	const int      count    = _DA_DETAIL count_digits(u);
+	DA_IFUNLIKELY(last - first < count + negative) {
+		return {last, std::errc::value_too_large};
+	}
+	if(negative) {
+		*first++ = '-';
+	}
+	first += count;
+	_DA_DETAIL write_digits_backward(first, u);
+	return {first, std::errc()};
+}
+
+/**
+ * @brief  Parse a decimal integer into @param value, which is the same as std::from_chars(first, last, value)
+ * @note   Neither leading spaces nor '+' is accepted, and '-' only for signed types
+ * @return Like std::from_chars, ptr points to the first character not parsed, and ec is
+ *         std::errc::invalid_argument if there is no digit, std::errc::result_out_of_range if it doesn't fit.
+ *         @param value is only modified on success
+ */
+template<_DA_DETAIL char_convertible_integral T>
+DA_CONSTEXPR std::from_chars_result from_chars(const char* first, const char* last, T& value) noexcept {
+	const char* p        = first;
+	bool        negative = false;
+	if constexpr(std::is_signed_v<T>) {
+		if(p != last && *p == '-') {
+			negative = true;
+			++p;
+		}
+	}
+	DA_IFUNLIKELY(p == last || !_DA_DETAIL is_digit(*p)) {
+		return {first, std::errc::invalid_argument};
+	}
+	uint64_t       u     = 0;
+	const bool     ok    = _DA_DETAIL parse_digits(p, last, u);
+	const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + uint64_t(negative);
+	DA_IFUNLIKELY(!ok || u > limit) {
+		return {p, std::errc::result_out_of_range};
+	}
+	value = static_cast<T>(negative ? uint64_t(0) - u : u);
+	return {p, std::errc()};
+}
+
+/**
+ * @brief Floating point in the shortest representation that round trips, by the standard library
+ *        which implements Ryu or a similar algorithm
+ */
+template<floating_point T>
+std::to_chars_result to_chars(char* first, char* last, T value) noexcept {
+	return std::to_chars(first, last, value);
+}
+
+template<floating_point T>
+std::from_chars_result from_chars(const char* first, const char* last, T& value) noexcept {
+	return std::from_chars(first, last, value);
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_UTILITY_CHARCONV_HPP_
@@ -0,0 +1,414 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      fixed_point_math.hpp
+ * @brief     Square root & transcendental functions of fixed_point without going through double
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#ifndef _DA_UTILITY_FIXED_POINT_MATH_HPP_
+#define _DA_UTILITY_FIXED_POINT_MATH_HPP_
+
+#include <da/config.hpp>
+#include <da/concepts.hpp>
+#include <da/utility/math.hpp>
+#include <da/utility/number.hpp>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <utility> // for std::pair
+
+DA_BEGIN_DETAIL
+
+/// (a * b) >> s, the highest bits of the 128-bit product
+[[nodiscard]] constexpr uint64_t mulshr(uint64_t a, uint64_t b, int s) noexcept {
+	return u128_shr(umul128(a, b), s).lo;
+}
+
+/// (a * b) >> s for signed values, rounded toward zero
+[[nodiscard]] constexpr int64_t mulshr(int64_t a, int64_t b, int s) noexcept {
+	const uint64_t ua = a < 0 ? uint64_t(0) - static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+	const uint64_t ub = b < 0 ? uint64_t(0) - static_cast<uint64_t>(b) : static_cast<uint64_t>(b);
+	const uint64_t m  = mulshr(ua, ub, s);
+	return (a < 0) != (b < 0) ? -static_cast<int64_t>(m) : static_cast<int64_t>(m);
+}
+
+/**
+ * @brief Constants & tables in binary fixed point, where Qn means n fractional bits
+ * @note  The constants are c = w0 + w1 * 2^-64 + w2 * 2^-128, so that they can be scaled exactly
+ */
+struct fixed_point_math_constants {
+	static inline constexpr uint64_t half_pi[3] = {1, 0x921FB54442D18469, 0x898CC51701B839A2};
+	static inline constexpr uint64_t ln2[3]     = {0, 0xB17217F7D1CF79AB, 0xC9E3B39803F2F6AF};
+	static inline constexpr uint64_t ln10[3]    = {2, 0x4D763776AAA2B05B, 0xA95B58AE0B4C28A3};
+
+	static inline constexpr int64_t  pi_q61      = 0x6487ED5110B4611A;
+	static inline constexpr int64_t  quarter_q62 = 0x3243F6A8885A308D; // pi / 4
+	static inline constexpr int64_t  half_pi_q62 = 0x6487ED5110B4611A;
+	static inline constexpr uint64_t ln2_q62     = 0x2C5C85FDF473DE6B;
+	static inline constexpr uint64_t sqrt2_q63   = 0xB504F333F9DE6484;
+
+	/// 1 / n! in Q62
+	static inline constexpr std::array<uint64_t, 21> inv_factorial = [] {
+		std::array<uint64_t, 21> t{};
+		t[0] = uint64_t(1) << 62;
+		for(size_t n = 1; n < t.size(); ++n) {
+			t[n] = t[n - 1] / n;
+		}
+		return t;
+	}();
+
+	/// 1 / (2k + 1) in Q63
+	static inline constexpr std::array<uint64_t, 14> inv_odd = [] {
+		std::array<uint64_t, 14> t{};
+		for(size_t k = 0; k < t.size(); ++k) {
+			t[k] = (uint64_t(1) << 63) / (2 * k + 1);
+		}
+		return t;
+	}();
+
+	/// atan(2^-i) in Q61 for CORDIC, by the series t - t^3/3 + t^5/5 - ..., where t = 2^-i
+	static inline constexpr std::array<int64_t, 62> atan_table = [] {
+		std::array<int64_t, 62> t{};
+		t[0] = 0x1921FB54442D1847; // pi / 4
+		for(size_t i = 1; i < t.size(); ++i) {
+			int64_t sum = 0;
+			for(size_t k = 0; i * (2 * k + 1) < 62; ++k) {
+				const int64_t term = (int64_t(1) << (61 - i * (2 * k + 1))) / static_cast<int64_t>(2 * k + 1);
+				sum += k % 2 == 0 ? term : -term;
+			}
+			t[i] = sum;
+		}
+		return t;
+	}();
+
+	/// c * m * 2^64 rounded down, where m * c < 2^64
+	[[nodiscard]] static constexpr u128 scale(const uint64_t (&c)[3], uint64_t m) noexcept {
+		u128 r = umul128(m, c[1]);
+		r      = u128_add(r, {umul128(m, c[2]).hi, m * c[0]});
+		return r;
+	}
+};
+
+/**
+ * @brief Square root & transcendental functions of integral fixed_point
+ * @note  The reduced arguments are computed exactly in 128 bits and evaluated in Q61 ~ Q64,
+ *        so the result is rounded to nearest with an error of at most 1 ULP plus about 2^-58 relatively
+ */
+template<integral Base, size_t Precision>
+struct fixed_point_math : fixed_point_math_constants {
+	typedef fixed_point_arith<Base, Precision> arith;
+
+	static inline constexpr uint64_t D = arith::D;
+
+	static inline constexpr u128 ln2_scaled     = scale(ln2, D);     // ln(2) * D * 2^64
+	static inline constexpr u128 half_pi_scaled = scale(half_pi, D); // pi / 2 * D * 2^64
+	static inline constexpr u128 ln_scale       = scale(ln10, Precision); // ln(D) * 2^64
+
+	/// Correctly rounded
+	[[nodiscard]] static DA_CONSTEXPR Base sqrt(Base x) noexcept {
+		DA_ASSERT(x >= 0);
+		const u128 n = umul128(static_cast<uint64_t>(x), D);
+		uint64_t   s = isqrt(n);
+		// Round up if n >= (s + 1/2)^2, i.e. n - s^2 > s
+		const u128 r = u128_sub(n, umul128(s, s));
+		if(r.hi != 0 || r.lo > s) {
+			++s;
+		}
+		return static_cast<Base>(s);
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR Base exp(Base x) noexcept {
+		const bool     negative = x < 0;
+		const uint64_t a        = _S_abs(x);
+		DA_IFUNLIKELY(arith::scale_divider::divide(a) >= 64) { // Far beyond the range of any Base
+			return negative ? Base(0) : std::numeric_limits<Base>::max();
+		}
+		// |x| = k * ln(2) + r, exp(-|x|) = 2^(-k-1) * exp(ln(2) - r)
+		auto [k, r]  = _S_reduce(a, ln2_scaled);
+		uint64_t rq  = _S_to_q(r, 62);
+		int      k2 = static_cast<int>(k);
+		if(negative) {
+			rq = ln2_q62 - rq;
+			k2 = -k2 - 1;
+		}
+		// Taylor series, ln(2)^20 / 20! < 2^-62
+		uint64_t e = inv_factorial[20];
+		for(size_t n = 20; n-- > 0;) {
+			e = inv_factorial[n] + mulshr(e, rq, 62);
+		}
+		// e * D * 2^(k2 - 62), rounded to nearest
+		const u128 m = umul128(e, D);
+		const int  s = 62 - k2;
+		if(s <= 0) {
+			DA_IFUNLIKELY(m.hi != 0 || (m.lo >> (63 + s)) != 0) {
+				return std::numeric_limits<Base>::max();
+			}
+			return _S_narrow({m.lo << -s, 0}, false);
+		}
+		if(s >= 128) {
+			return Base(0);
+		}
+		return _S_narrow(u128_shr(u128_add(m, u128_shr({0, uint64_t(1) << 63}, 128 - s)), s), false);
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR Base log(Base x) noexcept {
+		DA_ASSERT(x > 0);
+		const auto a = static_cast<uint64_t>(x);
+		// a = 2^e * m, where m is in [sqrt(1/2), sqrt(2)) in Q63
+		uint64_t e = static_cast<uint64_t>(std::bit_width(a) - 1);
+		uint64_t m = a << (63 - e);
+		if(m > sqrt2_q63) {
+			m >>= 1;
+			++e;
+		}
+		// ln(m) = 2 * atanh(z), where z = (m - 1) / (m + 1), |z| < 0.172 and z^28 / 27 < 2^-63
+		const bool     positive = m >= uint64_t(1) << 63;
+		const uint64_t num      = positive ? m - (uint64_t(1) << 63) : (uint64_t(1) << 63) - m;
+		const uint64_t den      = (m >> 1) + (uint64_t(1) << 62); // In Q62
+		uint64_t       rem;
+		const uint64_t z  = udiv128({num << 62, num >> 2}, den, rem); // In Q63
+		const uint64_t z2 = mulshr(z, z, 63);
+		uint64_t       p  = inv_odd[inv_odd.size() - 1];
+		for(size_t k = inv_odd.size() - 1; k-- > 0;) {
+			p = inv_odd[k] + mulshr(p, z2, 63);
+		}
+		const u128 l = u128_shr(umul128(z, p), 61); // 2 * z * p in Q64
+
+		// e * ln(2) +- l - ln(D)
+		u128 plus  = scale(ln2, e);
+		u128 minus = ln_scale;
+		if(positive) {
+			plus = u128_add(plus, l);
+		} else {
+			minus = u128_add(minus, l);
+		}
+		const bool negative = u128_less(plus, minus);
+		const u128 v        = negative ? u128_sub(minus, plus) : u128_sub(plus, minus);
+		// The integral part is v.hi, scale it & the rounded fractional part
+		u128 ret = umul128(v.hi, D);
+		ret      = u128_add(ret, {u128_add(umul128(v.lo, D), {uint64_t(1) << 63, 0}).hi, 0});
+		return _S_narrow(ret, negative);
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR Base sin(Base x) noexcept {
+		auto [q, r]   = _S_reduce_quadrant(x);
+		const int64_t v = q % 2 == 0 ? _S_sin(r) : _S_cos(r);
+		return _S_from_q(((q >= 2) != (x < 0)) ? -v : v, 62);
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR Base cos(Base x) noexcept {
+		auto [q, r]   = _S_reduce_quadrant(x);
+		const int64_t v = q % 2 == 0 ? _S_cos(r) : _S_sin(r);
+		return _S_from_q((q == 1 || q == 2) ? -v : v, 62);
+	}
+
+	/// CORDIC in vectoring mode, 62 iterations
+	[[nodiscard]] static DA_CONSTEXPR Base atan2(Base y, Base x) noexcept {
+		uint64_t ax = _S_abs(x), ay = _S_abs(y);
+		if(ax == 0 && ay == 0) {
+			return Base(0);
+		}
+		// Scale so that max(ax, ay) is in [2^60, 2^61), and then the gain of CORDIC (~1.65 * sqrt(2)) still fits
+		const int shift = 61 - std::bit_width(std::max(ax, ay));
+		if(shift >= 0) {
+			ax <<= shift;
+			ay <<= shift;
+		} else {
+			ax >>= -shift;
+			ay >>= -shift;
+		}
+		auto    vx = static_cast<int64_t>(ax);
+		auto    vy = static_cast<int64_t>(ay);
+		int64_t z  = 0;
+		// Branchless, the direction is hard to predict: rotate clockwise when vy >= 0
+		for(size_t i = 0; i < atan_table.size(); ++i) {
+			const int64_t s  = vy >> 63; // 0 or -1
+			const int64_t dx = vy >> i;
+			const int64_t dy = vx >> i;
+			vx += (dx ^ s) - s;
+			vy -= (dy ^ s) - s;
+			z += (atan_table[i] ^ s) - s;
+		}
+		if(x < 0) {
+			z = pi_q61 - z;
+		}
+		return _S_from_q(y < 0 ? -z : z, 61);
+	}
+
+	private:
+	struct reduction {
+		uint64_t k;
+		u128     r;
+	};
+
+	/**
+	 * @brief Reduce a / D = k * c + r / (D * 2^64), where 0 <= r < @param h = c * D * 2^64
+	 * @note  Each step of the loop removes most of the quotient, so it runs once or twice
+	 *        unless c * D is tiny, e.g. for Precision 0
+	 */
+	static DA_CONSTEXPR reduction _S_reduce(uint64_t a, u128 h) noexcept {
+		uint64_t k = a / (h.hi + 1); // Never more than the quotient
+		u128     r = u128_sub({0, a}, u128_mul(h, k));
+		while(r.hi > h.hi) {
+			const uint64_t q = r.hi / (h.hi + 1);
+			k += q;
+			r = u128_sub(r, u128_mul(h, q));
+		}
+		while(!u128_less(r, h)) {
+			r = u128_sub(r, h);
+			++k;
+		}
+		return {k, r};
+	}
+
+	/// r / (D * 2^64) in Q @param f, where r < c * D * 2^64 and c * 2^f < 2^64
+	static DA_CONSTEXPR uint64_t _S_to_q(u128 r, int f) noexcept {
+		return arith::divider.divide(u128_shr(r, 64 - f));
+	}
+
+	/// Reduce |x| to [-pi/4, pi/4] in Q62 with the quadrant
+	static DA_CONSTEXPR std::pair<unsigned, int64_t> _S_reduce_quadrant(Base x) noexcept {
+		auto [k, r] = _S_reduce(_S_abs(x), half_pi_scaled);
+		auto v      = static_cast<int64_t>(_S_to_q(r, 62));
+		if(v > quarter_q62) {
+			v -= half_pi_q62;
+			++k;
+		}
+		return {static_cast<unsigned>(k % 4), v};
+	}
+
+	/// Taylor series in Q62, (pi/4)^21 / 21! < 2^-62
+	static DA_CONSTEXPR int64_t _S_sin(int64_t x) noexcept {
+		const int64_t x2 = mulshr(x, x, 62);
+		int64_t       p  = -static_cast<int64_t>(inv_factorial[19]);
+		for(size_t k = 9; k-- > 0;) {
+			const auto c = static_cast<int64_t>(inv_factorial[2 * k + 1]);
+			p            = (k % 2 == 0 ? c : -c) + mulshr(p, x2, 62);
+		}
+		return mulshr(p, x, 62);
+	}
+
+	static DA_CONSTEXPR int64_t _S_cos(int64_t x) noexcept {
+		const int64_t x2 = mulshr(x, x, 62);
+		int64_t       p  = static_cast<int64_t>(inv_factorial[20]);
+		for(size_t k = 10; k-- > 0;) {
+			const auto c = static_cast<int64_t>(inv_factorial[2 * k]);
+			p            = (k % 2 == 0 ? c : -c) + mulshr(p, x2, 62);
+		}
+		return p;
+	}
+
+	/// v * D / 2^f, rounded to nearest
+	static DA_CONSTEXPR Base _S_from_q(int64_t v, int f) noexcept {
+		const bool negative = v < 0;
+		const u128 m        = umul128(_S_abs(v), D);
+		return _S_narrow(u128_shr(u128_add(m, {uint64_t(1) << (f - 1), 0}), f), negative);
+	}
+
+	/// Clamp to the range of Base
+	static DA_CONSTEXPR Base _S_narrow(u128 m, bool negative) noexcept {
+		const uint64_t limit = negative ? _S_abs(std::numeric_limits<Base>::min()) : static_cast<uint64_t>(std::numeric_limits<Base>::max());
+		DA_IFUNLIKELY(m.hi != 0 || m.lo > limit) {
+			return negative ? std::numeric_limits<Base>::min() : std::numeric_limits<Base>::max();
+		}
+		return static_cast<Base>(negative ? uint64_t(0) - m.lo : m.lo);
+	}
+
+	template<integral T>
+	static DA_CONSTEXPR uint64_t _S_abs(T x) noexcept {
+		const auto u = static_cast<uint64_t>(x);
+		return x < 0 ? uint64_t(0) - u : u;
+	}
+};
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief Square root, correctly rounded for integral Base
+ * @note  @param x must not be negative
+ */
+template<size_t P, arithmetic B>
+[[nodiscard]] DA_CONSTEXPR fixed_point<P, B> sqrt(fixed_point<P, B> x) noexcept {
+	if constexpr(std::is_integral_v<B>) {
+		return fixed_point<P, B>::from_raw(_DA_DETAIL fixed_point_math<B, P>::sqrt(x.raw()));
+	} else {
+		return fixed_point<P, B>(std::sqrt(x.template get<B>()));
+	}
+}
+
+/**
+ * @brief e^x, which is the maximum of the Base if it doesn't fit
+ * @note  The error is at most 1 ULP for integral Base while the result is less than 2^56 ULP
+ */
+template<size_t P, arithmetic B>
+[[nodiscard]] DA_CONSTEXPR fixed_point<P, B> exp(fixed_point<P, B> x) noexcept {
+	if constexpr(std::is_integral_v<B>) {
+		return fixed_point<P, B>::from_raw(_DA_DETAIL fixed_point_math<B, P>::exp(x.raw()));
+	} else {
+		return fixed_point<P, B>(std::exp(x.template get<B>()));
+	}
+}
+
+/**
+ * @brief Natural logarithm, @param x must be positive
+ * @note  The error is at most 1 ULP for integral Base of Precision <= 16
+ */
+template<size_t P, arithmetic B>
+	requires std::is_signed_v<B>
+[[nodiscard]] DA_CONSTEXPR fixed_point<P, B> log(fixed_point<P, B> x) noexcept {
+	if constexpr(std::is_integral_v<B>) {
+		return fixed_point<P, B>::from_raw(_DA_DETAIL fixed_point_math<B, P>::log(x.raw()));
+	} else {
+		return fixed_point<P, B>(std::log(x.template get<B>()));
+	}
+}
+
+/**
+ * @brief Sine of @param x in radians
+ * @note  The error is at most 1 ULP for integral Base of Precision <= 16, the argument reduction is exact
+ *        except that pi / 2 is rounded to 2^-64 ULP
+ */
+template<size_t P, arithmetic B>
+	requires std::is_signed_v<B>
+[[nodiscard]] DA_CONSTEXPR fixed_point<P, B> sin(fixed_point<P, B> x) noexcept {
+	if constexpr(std::is_integral_v<B>) {
+		return fixed_point<P, B>::from_raw(_DA_DETAIL fixed_point_math<B, P>::sin(x.raw()));
+	} else {
+		return fixed_point<P, B>(std::sin(x.template get<B>()));
+	}
+}
+
+/// Cosine of @param x in radians, the error is the same as sin()
+template<size_t P, arithmetic B>
+	requires std::is_signed_v<B>
+[[nodiscard]] DA_CONSTEXPR fixed_point<P, B> cos(fixed_point<P, B> x) noexcept {
+	if constexpr(std::is_integral_v<B>) {
+		return fixed_point<P, B>::from_raw(_DA_DETAIL fixed_point_math<B, P>::cos(x.raw()));
+	} else {
+		return fixed_point<P, B>(std::cos(x.template get<B>()));
+	}
+}
+
+/**
+ * @brief The angle of (x, y) in [-pi, pi], atan2(0, 0) returns 0
+ * @note  The error is at most 1 ULP for integral Base of Precision <= 15
+ */
+template<size_t P, arithmetic B>
+	requires std::is_signed_v<B>
+[[nodiscard]] DA_CONSTEXPR fixed_point<P, B> atan2(fixed_point<P, B> y, fixed_point<P, B> x) noexcept {
+	if constexpr(std::is_integral_v<B>) {
+		return fixed_point<P, B>::from_raw(_DA_DETAIL fixed_point_math<B, P>::atan2(y.raw(), x.raw()));
+	} else {
+		return fixed_point<P, B>(std::atan2(y.template get<B>(), x.template get<B>()));
+	}
+}
+
+DA_END_NAMESPACE
+
+#endif // _DA_UTILITY_FIXED_POINT_MATH_HPP_
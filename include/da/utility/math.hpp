@@ -14,10 +14,60 @@
 #include <da/config.hpp>
 #include <da/type_traits/config.hpp>
 #include <da/concepts.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cmath>
+#include <limits>
+#if DA_MSVC && defined(_M_X64)
+	#include <intrin.h> // for _umul128 & _udiv128
+#endif
+
+DA_BEGIN_DETAIL
+
+/// Number of powers of @tparam B representable in @tparam T, including B^0
+template<integral T, unsigned B>
+inline constexpr size_t power_table_size = [] {
+	size_t n = 1;
+	for(T x = 1; x <= std::numeric_limits<T>::max() / static_cast<T>(B); x *= static_cast<T>(B)) {
+		++n;
+	}
+	return n;
+}();
+
+/// B^0, B^1, ... up to the largest power representable in T
+template<integral T, unsigned B>
+inline constexpr std::array<T, power_table_size<T, B>> power_table = [] {
+	std::array<T, power_table_size<T, B>> t{};
+	t[0] = 1;
+	for(size_t i = 1; i < t.size(); ++i) {
+		t[i] = static_cast<T>(t[i - 1] * B);
+	}
+	return t;
+}();
+
+DA_END_DETAIL
 
 DA_BEGIN_NAMESPACE
 
+/**
+ * @brief 10^n by table lookup, @param n must be small enough that the result fits in T
+ */
+template<integral T = uint64_t>
+[[nodiscard]] DA_CONSTEXPR T pow10(size_t n) noexcept {
+	DA_ASSERT((n < _DA_DETAIL power_table_size<T, 10>));
+	return _DA_DETAIL power_table<T, 10>[n];
+}
+
+/**
+ * @brief 2^n, @param n must be small enough that the result fits in T
+ */
+template<integral T = uint64_t>
+[[nodiscard]] DA_CONSTEXPR T pow2(size_t n) noexcept {
+	DA_ASSERT(n < std::numeric_limits<T>::digits);
+	return static_cast<T>(T(1) << n);
+}
+
 /**
  * @brief Calculate base^exp
  * @tparam T Any arithmetic type
@@ -43,6 +93,14 @@ template<arithmetic T>
 			return 1 / pow(base, -exp);
 		}
 	} else {
+		if constexpr(std::is_integral_v<T>) { // The most common bases, by table or shift
+			if(base == 10 && static_cast<size_t>(exp) < _DA_DETAIL power_table_size<T, 10>) {
+				return pow10<T>(exp);
+			}
+			if(base == 2 && exp < std::numeric_limits<T>::digits) {
+				return pow2<T>(exp);
+			}
+		}
 		T      ret = 1, tmp = base;
 		size_t e = exp;
 		while(e) {
@@ -58,4 +116,425 @@ template<arithmetic T>
 
 DA_END_NAMESPACE
 
+DA_BEGIN_DETAIL
+
+#if DA_HAS_INT128
+__extension__ typedef unsigned __int128 native_uint128;
+#endif
+
+/// An unsigned 128-bit integer split into two halves, only used as intermediates
+struct u128 {
+	uint64_t lo;
+	uint64_t hi;
+};
+
+/**
+ * @brief Calculate the full 128-bit product of @param a and @param b
+ */
+[[nodiscard]] constexpr u128 umul128(uint64_t a, uint64_t b) noexcept {
+#if DA_HAS_INT128
+	const native_uint128 p = native_uint128(a) * b;
+	return {static_cast<uint64_t>(p), static_cast<uint64_t>(p >> 64)};
+#else
+	#if DA_MSVC && defined(_M_X64)
+	if(!std::is_constant_evaluated()) {
+		u128 r;
+		r.lo = _umul128(a, b, &r.hi);
+		return r;
+	}
+	#endif
+	const uint64_t p0  = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+	const uint64_t p1  = (a & 0xFFFFFFFF) * (b >> 32);
+	const uint64_t p2  = (a >> 32) * (b & 0xFFFFFFFF);
+	const uint64_t p3  = (a >> 32) * (b >> 32);
+	const uint64_t mid = (p0 >> 32) + (p1 & 0xFFFFFFFF) + (p2 & 0xFFFFFFFF);
+	return {(mid << 32) | (p0 & 0xFFFFFFFF), p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32)};
+#endif
+}
+
+/// Modular arithmetic of u128
+[[nodiscard]] constexpr u128 u128_add(u128 a, u128 b) noexcept {
+	const uint64_t lo = a.lo + b.lo;
+	return {lo, a.hi + b.hi + (lo < a.lo)};
+}
+
+[[nodiscard]] constexpr u128 u128_sub(u128 a, u128 b) noexcept {
+	return {a.lo - b.lo, a.hi - b.hi - (a.lo < b.lo)};
+}
+
+/// The lowest 128 bits of @param a * @param b
+[[nodiscard]] constexpr u128 u128_mul(u128 a, uint64_t b) noexcept {
+	u128 p = umul128(a.lo, b);
+	p.hi += a.hi * b;
+	return p;
+}
+
+[[nodiscard]] constexpr bool u128_less(u128 a, u128 b) noexcept {
+	return a.hi != b.hi ? a.hi < b.hi : a.lo < b.lo;
+}
+
+[[nodiscard]] constexpr u128 u128_shr(u128 a, int s) noexcept {
+	DA_ASSERT(s >= 0 && s < 128);
+	if(s >= 64) {
+		return {a.hi >> (s - 64), 0};
+	}
+	return {s == 0 ? a.lo : (a.lo >> s) | (a.hi << (64 - s)), a.hi >> s};
+}
+
+/**
+ * @brief  Divide the 128-bit @param n by @param d
+ * @param  r Set to the remainder
+ * @return The quotient
+ * @note   The quotient must fit in 64 bits, i.e. n.hi < d
+ */
+[[nodiscard]] constexpr uint64_t udiv128(u128 n, uint64_t d, uint64_t& r) noexcept {
+	DA_ASSERT(n.hi < d);
+	if(!std::is_constant_evaluated()) {
+#if(DA_GCC || DA_CLANG) && defined(__x86_64__)
+		uint64_t q; // A single divq, __udivti3 doesn't know the quotient fits
+		__asm__("divq %[d]" : "=a"(q), "=d"(r) : [d] "r"(d), "a"(n.lo), "d"(n.hi));
+		return q;
+#elif DA_MSVC && defined(_M_X64)
+		return _udiv128(n.hi, n.lo, d, &r);
+#endif
+	}
+#if DA_HAS_INT128
+	const native_uint128 x = (native_uint128(n.hi) << 64) | n.lo;
+	r                      = static_cast<uint64_t>(x % d);
+	return static_cast<uint64_t>(x / d);
+#else
+	// Knuth's algorithm D with 32-bit digits, from Hacker's Delight divlu()
+	constexpr uint64_t b = uint64_t(1) << 32;
+
+	const int s = std::countl_zero(d);
+	d <<= s;
+	const uint64_t un32 = s == 0 ? n.hi : (n.hi << s) | (n.lo >> (64 - s));
+	const uint64_t un10 = n.lo << s;
+	const uint64_t vn1 = d >> 32, vn0 = d & 0xFFFFFFFF;
+	const uint64_t un1 = un10 >> 32, un0 = un10 & 0xFFFFFFFF;
+
+	uint64_t q1 = un32 / vn1, rhat = un32 - q1 * vn1;
+	while(q1 >= b || q1 * vn0 > b * rhat + un1) {
+		--q1;
+		rhat += vn1;
+		if(rhat >= b) {
+			break;
+		}
+	}
+	const uint64_t un21 = un32 * b + un1 - q1 * d;
+
+	uint64_t q0 = un21 / vn1;
+	rhat        = un21 - q0 * vn1;
+	while(q0 >= b || q0 * vn0 > b * rhat + un0) {
+		--q0;
+		rhat += vn1;
+		if(rhat >= b) {
+			break;
+		}
+	}
+	r = (un21 * b + un0 - q0 * d) >> s;
+	return q1 * b + q0;
+#endif
+}
+
+/**
+ * @brief Divide 128-bit integers by a fixed 64-bit divisor with a precomputed reciprocal,
+ *        so that each division costs two multiplications instead of a hardware division
+ * @note  The 2-by-1 division of Möller & Granlund, "Improved division by invariant integers", 2011
+ * @note  The quotient must fit in 64 bits, i.e. n.hi < divisor
+ */
+class u128_divider {
+	public:
+	// Always constexpr so that the divider of a constant can be precomputed
+	explicit constexpr u128_divider(uint64_t d) noexcept
+		: m_shift(std::countl_zero(d))
+		, m_d(d << m_shift) {
+		DA_ASSERT(d != 0);
+		uint64_t r;
+		m_v = udiv128({~uint64_t(0), ~m_d}, m_d, r); // floor((2^128 - 1) / d) - 2^64
+	}
+
+	[[nodiscard]] DA_CONSTEXPR uint64_t divisor() const noexcept {
+		return m_d >> m_shift;
+	}
+
+	[[nodiscard]] DA_CONSTEXPR uint64_t divide(u128 n, uint64_t& rem) const noexcept {
+		DA_ASSERT(n.hi < divisor());
+		const uint64_t u1 = m_shift == 0 ? n.hi : (n.hi << m_shift) | (n.lo >> (64 - m_shift));
+		const uint64_t u0 = n.lo << m_shift;
+
+		u128 q = umul128(m_v, u1);
+		q.lo += u0;
+		q.hi += u1 + (q.lo < u0);
+		++q.hi;
+		uint64_t r = u0 - q.hi * m_d;
+		if(r > q.lo) {
+			--q.hi;
+			r += m_d;
+		}
+		DA_IFUNLIKELY(r >= m_d) {
+			++q.hi;
+			r -= m_d;
+		}
+		rem = r >> m_shift;
+		return q.hi;
+	}
+
+	[[nodiscard]] DA_CONSTEXPR uint64_t divide(u128 n) const noexcept {
+		uint64_t r;
+		return divide(n, r);
+	}
+
+	private:
+	int      m_shift;
+	uint64_t m_d; // Normalized divisor, the highest bit is set
+	uint64_t m_v = 0;
+};
+
+/**
+ * @brief Divide 64-bit unsigned integers by the constant @tparam D with a multiplication and shifts
+ * @note  The round-up method of Granlund & Montgomery, "Division by invariant integers using multiplication", 1994,
+ *        which is also libdivide's branchfree algorithm. The magic numbers are computed at compile time
+ * @note  Compilers do the same for a literal divisor, but not when D is a non-constexpr variable,
+ *        e.g. when DA_CONSTEXPR is disabled, and they never use the cheaper divisibility test
+ */
+template<uint64_t D>
+struct const_divider {
+	static_assert(D != 0, "Division by zero");
+
+	static inline constexpr bool is_pow2 = std::has_single_bit(D);
+	static inline constexpr int  shift   = std::bit_width(D - 1); // ceil(log2(D))
+
+	// m' = floor(2^64 * (2^shift - D) / D) + 1, the quotient fits in 64 bits since 2^shift - D < D
+	static inline constexpr uint64_t magic = [] {
+		if(is_pow2) {
+			return uint64_t(0);
+		}
+		uint64_t r;
+		return udiv128({0, (shift == 64 ? 0 : uint64_t(1) << shift) - D}, D, r) + 1;
+	}();
+
+	// D = odd << trailing_zeros, inverse * odd == 1 (mod 2^64)
+	static inline constexpr int      trailing_zeros = std::countr_zero(D);
+	static inline constexpr uint64_t inverse        = [] {
+		const uint64_t odd = D >> trailing_zeros;
+		uint64_t       x   = odd; // Correct for the lowest 3 bits, each Newton step doubles them
+		for(int i = 0; i < 5; ++i) {
+			x *= 2 - odd * x;
+		}
+		return x;
+	}();
+	static inline constexpr uint64_t max_quotient = ~uint64_t(0) / D;
+
+	[[nodiscard]] static DA_CONSTEXPR uint64_t divide(uint64_t n) noexcept {
+		if constexpr(is_pow2) {
+			return n >> shift;
+		} else {
+			const uint64_t t = umul128(magic, n).hi;
+			return (t + ((n - t) >> 1)) >> (shift - 1);
+		}
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR uint64_t remainder(uint64_t n) noexcept {
+		return n - divide(n) * D;
+	}
+
+	/// Whether n % D == 0, with a multiplication instead of a division
+	[[nodiscard]] static DA_CONSTEXPR bool is_divisor_of(uint64_t n) noexcept {
+		if constexpr(is_pow2) {
+			return (n & (D - 1)) == 0;
+		} else {
+			return std::rotr(n * inverse, trailing_zeros) <= max_quotient;
+		}
+	}
+};
+
+/// floor(sqrt(n)), estimated with the hardware square root at runtime & corrected by at most one
+[[nodiscard]] DA_CONSTEXPR uint64_t isqrt(uint64_t n) noexcept {
+	if(n < 2) {
+		return n;
+	}
+	if(std::is_constant_evaluated()) { // Newton's method from above
+		uint64_t y = uint64_t(1) << ((std::bit_width(n) + 1) / 2);
+		for(uint64_t z = (y + n / y) / 2; z < y; z = (y + n / y) / 2) {
+			y = z;
+		}
+		return y;
+	}
+	uint64_t y = std::min(static_cast<uint64_t>(std::sqrt(static_cast<double>(n))), uint64_t(0xFFFFFFFF));
+	while(y * y > n) {
+		--y;
+	}
+	while(y < 0xFFFFFFFF && (y + 1) * (y + 1) <= n) {
+		++y;
+	}
+	return y;
+}
+
+/**
+ * @brief floor(sqrt(n)) of 128-bit @param n with Newton's method, each step costs a 128-by-64 division
+ * @note  n.hi must not be 2^64 - 1, where the start value n.hi + 1 overflows
+ */
+[[nodiscard]] DA_CONSTEXPR uint64_t isqrt(u128 n) noexcept {
+	DA_ASSERT(n.hi != ~uint64_t(0));
+	if(n.hi == 0) {
+		return isqrt(n.lo);
+	}
+	uint64_t y;
+	if(std::is_constant_evaluated()) {
+		const int e = (128 - std::countl_zero(n.hi) + 1) / 2;
+		y           = e >= 64 ? ~uint64_t(0) : uint64_t(1) << e;
+	} else {
+		y = static_cast<uint64_t>(std::sqrt(static_cast<double>(n.hi) * 0x1p64 + static_cast<double>(n.lo)));
+	}
+	// The quotient fits in 64 bits as long as y > n.hi, which holds for y close to sqrt(n)
+	y = std::max(y, n.hi + 1);
+	// floor((y + n / y) / 2) >= floor(sqrt(n)) for any y, so the first step goes above the root
+	auto step = [n](uint64_t x) {
+		if(x <= n.hi) { // Only when x is already the root n.hi, since the root is never less than n.hi
+			return x;
+		}
+		uint64_t       r;
+		const uint64_t q = udiv128(n, x, r);
+		return (x >> 1) + (q >> 1) + (x & q & 1); // (x + q) / 2 without overflow
+	};
+	y = step(y);
+	for(uint64_t z = step(y); z < y; z = step(y)) {
+		y = z;
+	}
+	return y;
+}
+
+DA_END_DETAIL
+
+DA_BEGIN_NAMESPACE
+
+/**
+ * @brief floor(log2(x)), @param x must be positive
+ */
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR int ilog2(T x) noexcept {
+	DA_ASSERT(x > 0);
+	return std::bit_width(static_cast<std::make_unsigned_t<T>>(x)) - 1;
+}
+
+/**
+ * @brief floor(log10(x)), @param x must be positive
+ * @note  Estimated from the bit width and corrected by the table, without any division
+ */
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR int ilog10(T x) noexcept {
+	DA_ASSERT(x > 0);
+	typedef std::make_unsigned_t<T> U;
+	// log10(2) ~= 1233 / 4096, the guess is either exact or one more
+	const int t = (std::bit_width(static_cast<U>(x)) * 1233) >> 12;
+	return t - (static_cast<U>(x) < _DA_DETAIL power_table<U, 10>[t]);
+}
+
+/**
+ * @brief  floor(sqrt(x)) for integer @param x, which must not be negative
+ */
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR T isqrt(T x) noexcept {
+	DA_ASSERT(x >= 0);
+	return static_cast<T>(_DA_DETAIL isqrt(static_cast<uint64_t>(x)));
+}
+
+/// The same as isqrt(), kept for integers alongside sqrt() of fixed_point
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR T sqrt(T x) noexcept {
+	return isqrt(x);
+}
+
+/**
+ * @brief The smallest power of 2 not less than @param x, 1 for 0
+ * @note  The result must fit in T
+ */
+template<unsigned_integral T>
+[[nodiscard]] DA_CONSTEXPR T next_pow2(T x) noexcept {
+	DA_ASSERT(x <= (std::numeric_limits<T>::max() >> 1) + 1);
+	return std::bit_ceil(x);
+}
+
+/**
+ * @brief  Checked arithmetic, @param r is set to the wrapped result anyway
+ * @return Whether the result fits in T
+ */
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR bool checked_add(T a, T b, T& r) noexcept {
+#if DA_HAS_BUILTIN(__builtin_add_overflow)
+	return !__builtin_add_overflow(a, b, &r);
+#else
+	typedef std::make_unsigned_t<T> U;
+	r = static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+	if constexpr(std::is_signed_v<T>) {
+		return ((a ^ r) & (b ^ r)) >= 0; // Overflows only if the sign of r differs from both
+	} else {
+		return r >= a;
+	}
+#endif
+}
+
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR bool checked_sub(T a, T b, T& r) noexcept {
+#if DA_HAS_BUILTIN(__builtin_sub_overflow)
+	return !__builtin_sub_overflow(a, b, &r);
+#else
+	typedef std::make_unsigned_t<T> U;
+	r = static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+	if constexpr(std::is_signed_v<T>) {
+		return ((a ^ b) & (a ^ r)) >= 0; // Overflows only if a & b differ in sign and r differs from a
+	} else {
+		return a >= b;
+	}
+#endif
+}
+
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR bool checked_mul(T a, T b, T& r) noexcept {
+#if DA_HAS_BUILTIN(__builtin_mul_overflow)
+	return !__builtin_mul_overflow(a, b, &r);
+#else
+	static_assert(sizeof(T) <= 8, "Only types of at most 64 bits are supported");
+	typedef std::make_unsigned_t<T> U;
+	const uint64_t        ua       = a < 0 ? uint64_t(0) - static_cast<uint64_t>(a) : static_cast<uint64_t>(a);
+	const uint64_t        ub       = b < 0 ? uint64_t(0) - static_cast<uint64_t>(b) : static_cast<uint64_t>(b);
+	const _DA_DETAIL u128 p        = _DA_DETAIL umul128(ua, ub);
+	const bool            negative = (a < 0) != (b < 0); // Never for unsigned T
+	r                              = static_cast<T>(negative ? U(0) - static_cast<U>(p.lo) : static_cast<U>(p.lo));
+	const uint64_t limit           = static_cast<uint64_t>(std::numeric_limits<T>::max()) + negative;
+	return p.hi == 0 && p.lo <= limit;
+#endif
+}
+
+/// Saturating arithmetic, clamped to the range of T
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR T saturating_add(T a, T b) noexcept {
+	T r;
+	DA_IFUNLIKELY(!checked_add(a, b, r)) {
+		return std::is_signed_v<T> && a < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+	}
+	return r;
+}
+
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR T saturating_sub(T a, T b) noexcept {
+	T r;
+	DA_IFUNLIKELY(!checked_sub(a, b, r)) {
+		return std::is_signed_v<T> && a >= 0 ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+	}
+	return r;
+}
+
+template<integral T>
+[[nodiscard]] DA_CONSTEXPR T saturating_mul(T a, T b) noexcept {
+	T r;
+	DA_IFUNLIKELY(!checked_mul(a, b, r)) {
+		return (a < 0) != (b < 0) ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+	}
+	return r;
+}
+
+DA_END_NAMESPACE
+
 #endif // _DA_UTILITY_MATH_HPP_
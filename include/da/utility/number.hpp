@@ -15,7 +15,278 @@
 #include <da/type_traits/config.hpp>
 #include <da/concepts.hpp>
 #include <da/format.hpp>
+#include <da/utility/charconv.hpp>
 #include <da/utility/math.hpp>
+#include <algorithm>
+#include <cmath> // for std::fmod(), std::trunc()
+#include <limits>
+#include <string>
+#include <utility>
+
+DA_BEGIN_DETAIL
+
+/**
+ * @brief Calculate a * b / D and a * D / b for integral fixed_point without overflow in the intermediate
+ * @note  The result is rounded toward zero like integer division, and wraps if it doesn't fit in Base
+ */
+template<integral Base, size_t Precision>
+struct fixed_point_arith {
+	static_assert(sizeof(Base) <= 8, "Only Base of at most 64 bits is supported");
+
+	typedef std::make_unsigned_t<Base>                                    unsigned_type;
+	typedef std::conditional_t<std::is_signed_v<Base>, int64_t, uint64_t> wide_type;
+
+	// 10^Precision, not using pow10() since DA_CONSTEXPR may be disabled
+	static inline constexpr uint64_t D = power_table<uint64_t, 10>[Precision];
+
+	static inline constexpr u128_divider divider{D};
+
+	typedef const_divider<D> scale_divider;
+
+	[[nodiscard]] static DA_CONSTEXPR Base multiply(Base a, Base b) noexcept {
+		if constexpr(sizeof(Base) < 8) { // Never overflows in 64 bits
+			return static_cast<Base>(wide_type(a) * wide_type(b) / wide_type(D));
+		} else {
+			u128 p = umul128(_S_abs(a), _S_abs(b));
+			p.hi %= D; // Drop the bits of the quotient which doesn't fit in 64 bits
+			return _S_with_sign(divider.divide(p), (a < 0) != (b < 0));
+		}
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR Base divide(Base a, Base b) noexcept {
+		DA_ASSERT(b != 0);
+		if constexpr(sizeof(Base) < 8) {
+			return static_cast<Base>(wide_type(a) * wide_type(D) / wide_type(b));
+		} else {
+			const uint64_t d = _S_abs(b);
+			u128           p = umul128(_S_abs(a), D);
+			p.hi %= d;
+			uint64_t r;
+			return _S_with_sign(udiv128(p, d, r), (a < 0) != (b < 0));
+		}
+	}
+
+	/// x / D, rounded toward zero
+	[[nodiscard]] static DA_CONSTEXPR Base divide_scale(Base x) noexcept {
+		return _S_with_sign(scale_divider::divide(_S_abs(x)), x < 0);
+	}
+
+	/// Whether x % D == 0
+	[[nodiscard]] static DA_CONSTEXPR bool is_multiple_of_scale(Base x) noexcept {
+		return scale_divider::is_divisor_of(_S_abs(x));
+	}
+
+	private:
+	static DA_CONSTEXPR uint64_t _S_abs(Base x) noexcept {
+		const auto u = static_cast<unsigned_type>(x);
+		return x < 0 ? unsigned_type(0) - u : u; // Also works for the minimum value
+	}
+
+	static DA_CONSTEXPR Base _S_with_sign(uint64_t x, bool negative) noexcept {
+		return static_cast<Base>(negative ? uint64_t(0) - x : x);
+	}
+};
+
+/**
+ * @brief Arithmetic of binary_fixed_point, the scale is 2^FracBits so that rescaling is a shift
+ * @note  Results are rounded toward zero like fixed_point. If they don't fit in Base,
+ *        they wrap like unsigned integers, or are clamped to the limits of Base if @tparam Saturate
+ */
+template<integral Base, size_t FracBits, bool Saturate>
+struct binary_fixed_point_arith {
+	static_assert(sizeof(Base) <= 8, "Only Base of at most 64 bits is supported");
+	static_assert(FracBits < sizeof(Base) * 8, "The FracBits is too high for the Base type.");
+
+	typedef std::make_unsigned_t<Base>                                    unsigned_type;
+	typedef std::conditional_t<std::is_signed_v<Base>, int64_t, uint64_t> wide_type;
+
+	static inline constexpr uint64_t one  = uint64_t(1) << FracBits;
+	static inline constexpr Base     mask = static_cast<Base>(one - 1); // The fractional bits
+	static inline constexpr Base     min  = std::numeric_limits<Base>::min();
+	static inline constexpr Base     max  = std::numeric_limits<Base>::max();
+
+	[[nodiscard]] static DA_CONSTEXPR Base add(Base a, Base b) noexcept {
+		const auto r = static_cast<Base>(static_cast<unsigned_type>(a) + static_cast<unsigned_type>(b));
+		if constexpr(Saturate) {
+			if constexpr(std::is_signed_v<Base>) {
+				DA_IFUNLIKELY(((a ^ r) & (b ^ r)) < 0) { // Both operands have a sign different from r
+					return a < 0 ? min : max;
+				}
+			} else {
+				DA_IFUNLIKELY(r < a) {
+					return max;
+				}
+			}
+		}
+		return r;
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR Base subtract(Base a, Base b) noexcept {
+		const auto r = static_cast<Base>(static_cast<unsigned_type>(a) - static_cast<unsigned_type>(b));
+		if constexpr(Saturate) {
+			if constexpr(std::is_signed_v<Base>) {
+				DA_IFUNLIKELY(((a ^ b) & (a ^ r)) < 0) {
+					return a < 0 ? min : max;
+				}
+			} else {
+				DA_IFUNLIKELY(a < b) {
+					return min;
+				}
+			}
+		}
+		return r;
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR Base negate(Base a) noexcept {
+		return subtract(Base(0), a);
+	}
+
+	/// a * b / 2^FracBits
+	[[nodiscard]] static DA_CONSTEXPR Base multiply(Base a, Base b) noexcept {
+		if constexpr(sizeof(Base) < 8) { // The product never overflows in 64 bits
+			return narrow(wide_type(a) * wide_type(b) / wide_type(one));
+		} else {
+			return narrow(shift_right(umul128(abs(a), abs(b)), FracBits), (a < 0) != (b < 0));
+		}
+	}
+
+	/// a * 2^FracBits / b
+	[[nodiscard]] static DA_CONSTEXPR Base divide(Base a, Base b) noexcept {
+		DA_ASSERT(b != 0);
+		if constexpr(sizeof(Base) < 8) {
+			return narrow(wide_type(a) * wide_type(one) / wide_type(b));
+		} else {
+			const bool     negative = (a < 0) != (b < 0);
+			const uint64_t d        = abs(b);
+			u128           n        = shift_left(abs(a), FracBits);
+			DA_IFUNLIKELY(n.hi >= d) { // The quotient doesn't fit in 64 bits
+				if constexpr(Saturate) {
+					return negative ? min : max;
+				} else {
+					n.hi %= d;
+				}
+			}
+			uint64_t r;
+			return narrow({udiv128(n, d, r), 0}, negative);
+		}
+	}
+
+	/// a * b, where b is an integer
+	template<integral T>
+	[[nodiscard]] static DA_CONSTEXPR Base multiply_integer(Base a, T b) noexcept {
+		if constexpr(Saturate) {
+			return narrow(umul128(abs(a), abs(b)), (a < 0) != (b < 0));
+		} else {
+			return static_cast<Base>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b));
+		}
+	}
+
+	/// a / b, where b is an integer
+	template<integral T>
+	[[nodiscard]] static DA_CONSTEXPR Base divide_integer(Base a, T b) noexcept {
+		DA_ASSERT(b != 0);
+		return narrow({abs(a) / abs(b), 0}, (a < 0) != (b < 0)); // Only min / -1 overflows
+	}
+
+	/// x * 2^FracBits
+	template<integral T>
+	[[nodiscard]] static DA_CONSTEXPR Base from_integer(T x) noexcept {
+		if constexpr(Saturate) {
+			return narrow(shift_left(abs(x), FracBits), x < 0);
+		} else {
+			return static_cast<Base>(static_cast<uint64_t>(x) << FracBits);
+		}
+	}
+
+	/**
+	 * @brief Truncate @param x, which is already scaled, to Base
+	 * @note  Out of range values wrap modulo 2^bits without Saturate, NaN & infinities become 0
+	 */
+	template<floating_point T>
+	[[nodiscard]] static DA_CONSTEXPR Base from_floating(T x) noexcept {
+		// Both limits are exact in T since they are 0 or powers of 2
+		constexpr T lower = static_cast<T>(min);
+		constexpr T upper = static_cast<T>(max) + T(1);
+		DA_IFLIKELY(x >= lower && x < upper) {
+			return static_cast<Base>(x);
+		}
+		if(x != x) { // NaN
+			return Base(0);
+		}
+		if constexpr(Saturate) {
+			return x < lower ? min : max;
+		} else {
+			constexpr T modulus = T(2) * static_cast<T>(unsigned_type(1) << (sizeof(Base) * 8 - 1)); // 2^bits
+			const T     r       = std::fmod(std::trunc(x), modulus);                                 // In (-2^bits, 2^bits), NaN for infinities
+			if(r != r) {
+				return Base(0);
+			}
+			// |r| < 2^bits is an integer, so it fits in unsigned_type
+			return static_cast<Base>(r < T(0) ? unsigned_type(0) - static_cast<unsigned_type>(-r) : static_cast<unsigned_type>(r));
+		}
+	}
+
+	/// Rescale @param x of FromBits fractional bits, rounded toward zero
+	template<size_t FromBits, integral T>
+	[[nodiscard]] static DA_CONSTEXPR Base rescale(T x) noexcept {
+		if constexpr(FracBits >= FromBits) {
+			return narrow(shift_left(abs(x), FracBits - FromBits), x < 0);
+		} else {
+			return narrow({abs(x) >> (FromBits - FracBits), 0}, x < 0);
+		}
+	}
+
+	/// x / 2^FracBits, rounded toward zero
+	[[nodiscard]] static DA_CONSTEXPR Base truncate(Base x) noexcept {
+		return with_sign(abs(x) >> FracBits, x < 0);
+	}
+
+	/// Narrow a 64-bit intermediate to Base
+	[[nodiscard]] static DA_CONSTEXPR Base narrow(wide_type x) noexcept {
+		if constexpr(Saturate && sizeof(Base) < 8) {
+			DA_IFUNLIKELY(x < wide_type(min)) {
+				return min;
+			}
+			DA_IFUNLIKELY(x > wide_type(max)) {
+				return max;
+			}
+		}
+		return static_cast<Base>(x);
+	}
+
+	/// Narrow a magnitude @param m with sign @param negative to Base
+	[[nodiscard]] static DA_CONSTEXPR Base narrow(u128 m, bool negative) noexcept {
+		if constexpr(Saturate) {
+			const uint64_t limit = negative ? abs(min) : static_cast<uint64_t>(max);
+			DA_IFUNLIKELY(m.hi != 0 || m.lo > limit) {
+				return negative ? min : max;
+			}
+		}
+		return with_sign(m.lo, negative);
+	}
+
+	template<integral T>
+	[[nodiscard]] static DA_CONSTEXPR uint64_t abs(T x) noexcept {
+		const auto u = static_cast<uint64_t>(x);
+		return x < 0 ? uint64_t(0) - u : u; // Also works for the minimum value
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR Base with_sign(uint64_t x, bool negative) noexcept {
+		return static_cast<Base>(negative ? uint64_t(0) - x : x);
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR u128 shift_left(uint64_t x, size_t s) noexcept {
+		DA_ASSERT(s < 64);
+		return {x << s, s == 0 ? 0 : x >> (64 - s)};
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR u128 shift_right(u128 x, size_t s) noexcept {
+		DA_ASSERT(s < 64);
+		return {s == 0 ? x.lo : (x.lo >> s) | (x.hi << (64 - s)), x.hi >> s};
+	}
+};
+
+DA_END_DETAIL
 
 DA_BEGIN_NAMESPACE
 
@@ -23,9 +294,18 @@ DA_BEGIN_NAMESPACE
 struct no_conversion_t { };
 inline DA_CONSTEXPR no_conversion_t no_conversion;
 
+/// What binary_fixed_point does when the result doesn't fit
+enum class overflow_policy {
+	wrap,    // Wrap around like unsigned integers, which is the cheapest
+	saturate // Clamp to the minimum or maximum
+};
+
 template<size_t Precision, arithmetic Base = int64_t>
 class fixed_point;
 
+template<size_t FracBits, integral Base = int32_t, overflow_policy Policy = overflow_policy::wrap>
+class binary_fixed_point;
+
 template<size_t Precision, arithmetic Base>
 class fixed_point {
 	static_assert(!std::is_same_v<Base, bool>, "bool is not supported to be base of fixed_point");
@@ -51,12 +331,21 @@ class fixed_point {
 
 	template<size_t P2, arithmetic B2>
 	DA_CONSTEXPR fixed_point(fixed_point<P2, B2> other) noexcept
-		: _value(other.raw() * precision_in_10 / other.precision_in_10) { }
+		: _value(_S_rescale(other)) { }
+
+	/// Rounded toward zero, wraps if it doesn't fit
+	template<size_t F, integral B2, overflow_policy O>
+	explicit DA_CONSTEXPR fixed_point(binary_fixed_point<F, B2, O> other) noexcept
+		: _value(_S_from_binary(other)) { }
 
 	/// getter & setter
 	template<arithmetic T>
 	[[nodiscard]] DA_CONSTEXPR T get() const noexcept {
-		return static_cast<T>(_value) / precision_in_10;
+		if constexpr(std::is_integral_v<T> && std::is_integral_v<Base>) { // Truncate after division
+			return static_cast<T>(_DA_DETAIL fixed_point_arith<Base, Precision>::divide_scale(_value));
+		} else {
+			return static_cast<T>(_value) / precision_in_10;
+		}
 	}
 
 	template<arithmetic T>
@@ -83,8 +372,12 @@ class fixed_point {
 	}
 
 	/// Misc
-	[[nodiscard]] DA_CONSTEXPR bool is_integer() noexcept {
-		return _value % precision_in_10 == 0;
+	[[nodiscard]] DA_CONSTEXPR bool is_integer() const noexcept {
+		if constexpr(std::is_integral_v<Base>) {
+			return _DA_DETAIL fixed_point_arith<Base, Precision>::is_multiple_of_scale(_value);
+		} else {
+			return std::trunc(_value / precision_in_10) * precision_in_10 == _value;
+		}
 	}
 
 	/// Basic operations
@@ -106,8 +399,13 @@ class fixed_point {
 		return from_raw(_value - other * precision_in_10);
 	}
 
+	/// Exact for integral Base, the intermediate product is of 128 bits
 	[[nodiscard]] DA_CONSTEXPR fixed_point multiply(fixed_point other) const noexcept {
-		return from_raw(_value * other._value / precision_in_10);
+		if constexpr(std::is_integral_v<Base>) {
+			return from_raw(_DA_DETAIL fixed_point_arith<Base, Precision>::multiply(_value, other._value));
+		} else {
+			return from_raw(_value * other._value / precision_in_10);
+		}
 	}
 
 	template<arithmetic T>
@@ -115,8 +413,13 @@ class fixed_point {
 		return from_raw(_value * other);
 	}
 
+	/// Exact for integral Base, the intermediate product is of 128 bits
 	[[nodiscard]] DA_CONSTEXPR fixed_point divide(fixed_point other) const noexcept {
-		return from_raw(_value * precision_in_10 / other._value);
+		if constexpr(std::is_integral_v<Base>) {
+			return from_raw(_DA_DETAIL fixed_point_arith<Base, Precision>::divide(_value, other._value));
+		} else {
+			return from_raw(_value * precision_in_10 / other._value);
+		}
 	}
 
 	template<arithmetic T>
@@ -152,8 +455,7 @@ class fixed_point {
 	}
 
 	DA_CONSTEXPR fixed_point& operator*=(fixed_point other) noexcept {
-		_value = _value * other._value / precision_in_10;
-		return *this;
+		return *this = multiply(other);
 	}
 
 	template<arithmetic T>
@@ -163,8 +465,7 @@ class fixed_point {
 	}
 
 	DA_CONSTEXPR fixed_point& operator/=(fixed_point other) noexcept {
-		_value = _value * precision_in_10 / other._value;
-		return *this;
+		return *this = divide(other);
 	}
 
 	template<arithmetic T>
@@ -190,6 +491,30 @@ class fixed_point {
 	DA_CONSTEXPR std::strong_ordering operator<=>(T other) const noexcept {
 		return _value <=> (other * precision_in_10);
 	}
+
+	private:
+	/// Scale by 10^(Precision - P2) with a single multiplication or division
+	template<size_t P2, arithmetic B2>
+	static DA_CONSTEXPR Base _S_rescale(fixed_point<P2, B2> other) noexcept {
+		if constexpr(!std::is_integral_v<Base> || !std::is_integral_v<B2>) {
+			return other.raw() * precision_in_10 / other.precision_in_10;
+		} else if constexpr(Precision >= P2) {
+			return static_cast<Base>(other.raw()) * static_cast<Base>(_DA_DETAIL fixed_point_arith<Base, Precision - P2>::D);
+		} else {
+			return static_cast<Base>(_DA_DETAIL fixed_point_arith<B2, P2 - Precision>::divide_scale(other.raw()));
+		}
+	}
+
+	template<size_t F, integral B2, overflow_policy O>
+	static DA_CONSTEXPR Base _S_from_binary(binary_fixed_point<F, B2, O> other) noexcept {
+		if constexpr(std::is_integral_v<Base>) {
+			typedef _DA_DETAIL binary_fixed_point_arith<B2, F, false> arith;
+			const auto m = arith::shift_right(_DA_DETAIL umul128(arith::abs(other.raw()), _DA_DETAIL fixed_point_arith<Base, Precision>::D), F);
+			return static_cast<Base>(other.raw() < 0 ? uint64_t(0) - m.lo : m.lo);
+		} else {
+			return other.template get<Base>() * precision_in_10;
+		}
+	}
 };
 
 template<size_t P, arithmetic B>
@@ -252,9 +577,533 @@ template<size_t P, arithmetic B, arithmetic T>
 	return fixed_point<P, B>(x).divide(y);
 }
 
+/**
+ * @brief A fixed point number of @tparam FracBits fractional bits, i.e. Q-format
+ * @note  Unlike fixed_point, the scale is 2^FracBits, so multiplication and division rescale by a shift
+ *        instead of a multiplication or division by a power of 10
+ * @note  Results are rounded toward zero, and wrap or saturate according to @tparam Policy
+ */
+template<size_t FracBits, integral Base, overflow_policy Policy>
+class binary_fixed_point {
+	static_assert(!std::is_same_v<Base, bool>, "bool is not supported to be base of binary_fixed_point");
+
+	typedef _DA_DETAIL binary_fixed_point_arith<Base, FracBits, Policy == overflow_policy::saturate> arith;
+
+	Base _value;
+
+	public:
+	static inline constexpr size_t          frac_bits = FracBits;
+	static inline constexpr overflow_policy policy    = Policy;
+
+	/// Constructors
+	DA_CONSTEXPR binary_fixed_point() noexcept
+		: _value() { }
+
+	template<arithmetic T>
+	DA_CONSTEXPR binary_fixed_point(T value) noexcept
+		: _value(_S_from(value)) { }
+
+	template<arithmetic T>
+	DA_CONSTEXPR binary_fixed_point(T value, no_conversion_t) noexcept
+		: _value(value) { }
+
+	template<size_t F2, integral B2, overflow_policy O2>
+	DA_CONSTEXPR binary_fixed_point(binary_fixed_point<F2, B2, O2> other) noexcept
+		: _value(arith::template rescale<F2>(other.raw())) { }
+
+	/// Rounded toward zero
+	template<size_t P, arithmetic B2>
+	explicit DA_CONSTEXPR binary_fixed_point(fixed_point<P, B2> other) noexcept
+		: _value(_S_from_decimal(other)) { }
+
+	/// getter & setter
+	template<arithmetic T>
+	[[nodiscard]] DA_CONSTEXPR T get() const noexcept {
+		if constexpr(std::is_integral_v<T>) {
+			return static_cast<T>(arith::truncate(_value));
+		} else {
+			return static_cast<T>(_value) * (T(1) / static_cast<T>(arith::one)); // Exact since the scale is a power of 2
+		}
+	}
+
+	template<arithmetic T>
+	[[nodiscard]] DA_CONSTEXPR operator T() const noexcept {
+		return get<T>();
+	}
+
+	template<arithmetic T>
+	DA_CONSTEXPR binary_fixed_point& set(T v) noexcept {
+		_value = _S_from(v);
+		return *this;
+	}
+
+	[[nodiscard]] DA_CONSTEXPR Base raw() const noexcept {
+		return _value;
+	}
+
+	[[nodiscard]] DA_CONSTEXPR Base& raw() noexcept {
+		return _value;
+	}
+
+	[[nodiscard]] static DA_CONSTEXPR binary_fixed_point from_raw(Base value) noexcept {
+		return {value, no_conversion};
+	}
+
+	/// Misc
+	[[nodiscard]] DA_CONSTEXPR bool is_integer() const noexcept {
+		return (_value & arith::mask) == 0;
+	}
+
+	/// Basic operations
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point add(binary_fixed_point other) const noexcept {
+		return from_raw(arith::add(_value, other._value));
+	}
+
+	template<arithmetic T>
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point add(T other) const noexcept {
+		return add(binary_fixed_point(other));
+	}
+
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point subtract(binary_fixed_point other) const noexcept {
+		return from_raw(arith::subtract(_value, other._value));
+	}
+
+	template<arithmetic T>
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point subtract(T other) const noexcept {
+		return subtract(binary_fixed_point(other));
+	}
+
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point multiply(binary_fixed_point other) const noexcept {
+		return from_raw(arith::multiply(_value, other._value));
+	}
+
+	template<arithmetic T>
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point multiply(T other) const noexcept {
+		if constexpr(std::is_integral_v<T>) {
+			return from_raw(arith::multiply_integer(_value, other));
+		} else {
+			return from_raw(arith::from_floating(_value * other));
+		}
+	}
+
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point divide(binary_fixed_point other) const noexcept {
+		return from_raw(arith::divide(_value, other._value));
+	}
+
+	template<arithmetic T>
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point divide(T other) const noexcept {
+		if constexpr(std::is_integral_v<T>) {
+			return from_raw(arith::divide_integer(_value, other));
+		} else {
+			return from_raw(arith::from_floating(_value / other));
+		}
+	}
+
+	/// Operators
+	[[nodiscard]] DA_CONSTEXPR binary_fixed_point operator-() const noexcept {
+		return from_raw(arith::negate(_value));
+	}
+
+	DA_CONSTEXPR binary_fixed_point& operator+=(binary_fixed_point other) noexcept {
+		return *this = add(other);
+	}
+
+	template<arithmetic T>
+	DA_CONSTEXPR binary_fixed_point& operator+=(T other) noexcept {
+		return *this = add(other);
+	}
+
+	DA_CONSTEXPR binary_fixed_point& operator-=(binary_fixed_point other) noexcept {
+		return *this = subtract(other);
+	}
+
+	template<arithmetic T>
+	DA_CONSTEXPR binary_fixed_point& operator-=(T other) noexcept {
+		return *this = subtract(other);
+	}
+
+	DA_CONSTEXPR binary_fixed_point& operator*=(binary_fixed_point other) noexcept {
+		return *this = multiply(other);
+	}
+
+	template<arithmetic T>
+	DA_CONSTEXPR binary_fixed_point& operator*=(T other) noexcept {
+		return *this = multiply(other);
+	}
+
+	DA_CONSTEXPR binary_fixed_point& operator/=(binary_fixed_point other) noexcept {
+		return *this = divide(other);
+	}
+
+	template<arithmetic T>
+	DA_CONSTEXPR binary_fixed_point& operator/=(T other) noexcept {
+		return *this = divide(other);
+	}
+
+	DA_CONSTEXPR bool operator==(binary_fixed_point other) const noexcept {
+		return _value == other._value;
+	}
+
+	template<arithmetic T>
+	DA_CONSTEXPR bool operator==(T other) const noexcept {
+		return (*this <=> other) == 0;
+	}
+
+	DA_CONSTEXPR std::strong_ordering operator<=>(binary_fixed_point other) const noexcept {
+		return _value <=> other._value;
+	}
+
+	/// Exact, the integer is never scaled so it cannot overflow
+	template<integral T>
+	DA_CONSTEXPR std::strong_ordering operator<=>(T other) const noexcept {
+		const Base i = static_cast<Base>(_value >> FracBits); // Rounded toward negative infinity
+		if(std::cmp_equal(i, other)) {
+			return (_value & arith::mask) == 0 ? std::strong_ordering::equal : std::strong_ordering::greater;
+		}
+		return std::cmp_less(i, other) ? std::strong_ordering::less : std::strong_ordering::greater;
+	}
+
+	template<floating_point T>
+	DA_CONSTEXPR std::partial_ordering operator<=>(T other) const noexcept {
+		return get<T>() <=> other;
+	}
+
+	private:
+	template<arithmetic T>
+	static DA_CONSTEXPR Base _S_from(T value) noexcept {
+		if constexpr(std::is_integral_v<T>) {
+			return arith::from_integer(value);
+		} else {
+			return arith::from_floating(value * static_cast<T>(arith::one));
+		}
+	}
+
+	/// other.raw() * 2^FracBits / 10^P in 128 bits
+	template<size_t P, arithmetic B2>
+	static DA_CONSTEXPR Base _S_from_decimal(fixed_point<P, B2> other) noexcept {
+		if constexpr(std::is_integral_v<B2>) {
+			typedef _DA_DETAIL fixed_point_arith<B2, P> decimal;
+
+			const bool      negative = other.raw() < 0;
+			_DA_DETAIL u128 n        = arith::shift_left(arith::abs(other.raw()), FracBits);
+			DA_IFUNLIKELY(n.hi >= decimal::D) {
+				if constexpr(Policy == overflow_policy::saturate) {
+					return negative ? arith::min : arith::max;
+				} else {
+					n.hi %= decimal::D;
+				}
+			}
+			return arith::narrow({decimal::divider.divide(n), 0}, negative);
+		} else {
+			return _S_from(other.template get<B2>());
+		}
+	}
+};
+
+template<size_t F, integral B, overflow_policy O>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator+(binary_fixed_point<F, B, O> x, binary_fixed_point<F, B, O> y) noexcept {
+	return x.add(y);
+}
+
+template<size_t F, integral B, overflow_policy O, arithmetic T>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator+(binary_fixed_point<F, B, O> x, T y) noexcept {
+	return x.add(y);
+}
+
+template<size_t F, integral B, overflow_policy O, arithmetic T>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator+(T x, binary_fixed_point<F, B, O> y) noexcept {
+	return y.add(x);
+}
+
+template<size_t F, integral B, overflow_policy O>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator-(binary_fixed_point<F, B, O> x, binary_fixed_point<F, B, O> y) noexcept {
+	return x.subtract(y);
+}
+
+template<size_t F, integral B, overflow_policy O, arithmetic T>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator-(binary_fixed_point<F, B, O> x, T y) noexcept {
+	return x.subtract(y);
+}
+
+template<size_t F, integral B, overflow_policy O, arithmetic T>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator-(T x, binary_fixed_point<F, B, O> y) noexcept {
+	return binary_fixed_point<F, B, O>(x).subtract(y);
+}
+
+template<size_t F, integral B, overflow_policy O>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator*(binary_fixed_point<F, B, O> x, binary_fixed_point<F, B, O> y) noexcept {
+	return x.multiply(y);
+}
+
+template<size_t F, integral B, overflow_policy O, arithmetic T>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator*(binary_fixed_point<F, B, O> x, T y) noexcept {
+	return x.multiply(y);
+}
+
+template<size_t F, integral B, overflow_policy O, arithmetic T>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator*(T x, binary_fixed_point<F, B, O> y) noexcept {
+	return y.multiply(x);
+}
+
+template<size_t F, integral B, overflow_policy O>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator/(binary_fixed_point<F, B, O> x, binary_fixed_point<F, B, O> y) noexcept {
+	return x.divide(y);
+}
+
+template<size_t F, integral B, overflow_policy O, arithmetic T>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator/(binary_fixed_point<F, B, O> x, T y) noexcept {
+	return x.divide(y);
+}
+
+template<size_t F, integral B, overflow_policy O, arithmetic T>
+[[nodiscard]] DA_CONSTEXPR binary_fixed_point<F, B, O> operator/(T x, binary_fixed_point<F, B, O> y) noexcept {
+	return binary_fixed_point<F, B, O>(x).divide(y);
+}
+
+/// Q-format aliases, e.g. q16_16 has 16 integral bits (including the sign) & 16 fractional bits
+using q1_15  = binary_fixed_point<15, int16_t>;
+using q1_31  = binary_fixed_point<31, int32_t>;
+using q16_16 = binary_fixed_point<16, int32_t>;
+using q32_32 = binary_fixed_point<32, int64_t>;
+
+/// Conversion from & to characters
+
+/**
+ * @brief  Write @param v as a decimal number without exponent
+ * @param  precision The number of fractional digits, rounded half away from zero.
+ *                   If negative, the shortest exact representation is written, e.g. 1.50000 -> "1.5", 2.00000 -> "2"
+ * @return Like std::to_chars, {last, std::errc::value_too_large} if there is not enough space
+ */
+template<size_t P, integral B>
+DA_CONSTEXPR std::to_chars_result to_chars(char* first, char* last, fixed_point<P, B> v, int precision = -1) noexcept {
+	typedef _DA_DETAIL fixed_point_arith<B, P> arith;
+
+	const B        raw = v.raw();
+	const uint64_t u   = raw < 0 ? uint64_t(0) - static_cast<uint64_t>(raw) : static_cast<uint64_t>(raw);
+	uint64_t       ip  = arith::scale_divider::divide(u);
+	uint64_t       fp  = u - ip * arith::D;
+	int            fd  = static_cast<int>(P); // Digits of fp
+	int            pad = 0;                   // Trailing zeros after fp
+
+	if(precision < 0) {
+		if(fp == 0) {
+			fd = 0;
+		} else {
+			while(fp % 10 == 0) {
+				fp /= 10;
+				--fd;
+			}
+		}
+	} else if(precision < fd) {
+		const uint64_t k = _DA_DETAIL power_table<uint64_t, 10>[fd - precision];
+		const uint64_t r = fp % k;
+		fp /= k;
+		if(r >= k - r) { // Round half away from zero
+			++fp;
+			if(fp == _DA_DETAIL power_table<uint64_t, 10>[precision]) {
+				fp = 0;
+				++ip;
+			}
+		}
+		fd = precision;
+	} else {
+		pad = precision - fd;
+	}
+
+	const int    id = _DA_DETAIL count_digits(ip);
+	const size_t n  = size_t(raw < 0) + id + (fd + pad > 0 ? 1 + fd + pad : 0);
+	DA_IFUNLIKELY(static_cast<size_t>(last - first) < n) {
+		return {last, std::errc::value_too_large};
+	}
+	char* p = first;
+	if(raw < 0) {
+		*p++ = '-';
+	}
+	p += id;
+	_DA_DETAIL write_digits_backward(p, ip);
+	if(fd + pad > 0) {
+		*p++ = '.';
+		p += fd;
+		_DA_DETAIL write_fixed_digits_backward(p, fp, fd);
+		p = std::fill_n(p, pad, '0');
+	}
+	return {p, std::errc()};
+}
+
+/**
+ * @brief  Parse a decimal number like "-123.456" into @param v
+ * @note   Like std::from_chars, neither leading spaces, '+' nor exponent is accepted
+ * @note   Extra fractional digits are rounded half away from zero
+ * @return Like std::from_chars, ptr points to the first character not parsed, and ec is
+ *         std::errc::invalid_argument if there is no digit, std::errc::result_out_of_range if it doesn't fit.
+ *         @param v is only modified on success
+ */
+template<size_t P, integral B>
+DA_CONSTEXPR std::from_chars_result from_chars(const char* first, const char* last, fixed_point<P, B>& v) noexcept {
+	typedef _DA_DETAIL fixed_point_arith<B, P> arith;
+
+	const char* p        = first;
+	bool        negative = false;
+	if constexpr(std::is_signed_v<B>) {
+		if(p != last && *p == '-') {
+			negative = true;
+			++p;
+		}
+	}
+
+	const char* digits   = p;
+	uint64_t    ip       = 0;
+	const bool  overflow = !_DA_DETAIL parse_digits(p, last, ip);
+	bool        any      = p != digits;
+
+	uint64_t fp = 0;
+	size_t   fd = 0;
+	bool     up = false; // Round up
+	if(p != last && *p == '.' && (any || (p + 1 != last && _DA_DETAIL is_digit(p[1])))) {
+		++p;
+		for(; p != last && _DA_DETAIL is_digit(*p); ++p) {
+			if(fd < P) {
+				fp = fp * 10 + static_cast<uint64_t>(*p - '0');
+				++fd;
+			} else if(fd++ == P) { // The first digit dropped
+				up = *p >= '5';
+			}
+		}
+		any = true;
+	}
+	DA_IFUNLIKELY(!any) {
+		return {first, std::errc::invalid_argument};
+	}
+	if(fd < P) {
+		fp *= _DA_DETAIL power_table<uint64_t, 10>[P - fd];
+	}
+
+	// The magnitude of the result, the limit of negative values is one more
+	const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<B>::max()) + uint64_t(negative);
+	const auto     prod  = _DA_DETAIL umul128(ip, arith::D);
+	const uint64_t u     = prod.lo + fp + uint64_t(up);
+	DA_IFUNLIKELY(overflow || prod.hi != 0 || u < prod.lo || u > limit) {
+		return {p, std::errc::result_out_of_range};
+	}
+	v = fixed_point<P, B>::from_raw(static_cast<B>(negative ? uint64_t(0) - u : u));
+	return {p, std::errc()};
+}
+
 DA_END_NAMESPACE
 
-template<size_t P, _DA arithmetic B, typename CharT>
+/**
+ * @brief Format integral fixed_point exactly without converting to double
+ * @note  The format spec is [[fill]align][sign][0][width][.precision][f], fill is a single code unit.
+ *        Without precision, the shortest exact representation is used
+ */
+template<size_t P, _DA integral B, typename CharT>
+struct _DAFMT formatter<_DA fixed_point<P, B>, CharT> {
+	template<typename ParseContext>
+	constexpr auto parse(ParseContext& ctx) {
+		auto       it  = ctx.begin();
+		const auto end = ctx.end();
+
+		auto is_align = [](CharT c) { return c == CharT('<') || c == CharT('>') || c == CharT('^'); };
+		if(it != end && it + 1 != end && is_align(it[1]) && *it != CharT('{') && *it != CharT('}')) {
+			m_fill  = *it;
+			m_align = static_cast<char>(it[1]);
+			it += 2;
+		} else if(it != end && is_align(*it)) {
+			m_align = static_cast<char>(*it++);
+		}
+		if(it != end && (*it == CharT('+') || *it == CharT('-') || *it == CharT(' '))) {
+			m_sign = static_cast<char>(*it++);
+		}
+		if(it != end && *it == CharT('0')) {
+			m_zero = true;
+			++it;
+		}
+		it = _S_parse_int(it, end, m_width);
+		if(it != end && *it == CharT('.')) {
+			++it;
+			DA_IFUNLIKELY(it == end || *it < CharT('0') || *it > CharT('9')) {
+				DA_THROW(_DAFMT format_error("da::formatter<fixed_point>::parse: Missing precision"));
+			}
+			m_precision = 0;
+			it          = _S_parse_int(it, end, m_precision);
+		}
+		if(it != end && (*it == CharT('f') || *it == CharT('F'))) {
+			++it;
+		}
+		DA_IFUNLIKELY(it != end && *it != CharT('}')) {
+			DA_THROW(_DAFMT format_error("da::formatter<fixed_point>::parse: Invalid format specifier"));
+		}
+		return it;
+	}
+
+	template<typename FormatContext>
+	auto format(const _DA fixed_point<P, B>& v, FormatContext& ctx) const {
+		constexpr int inline_digits = 40;
+
+		char        small[1 + 20 + 1 + inline_digits + P];
+		std::string large; // Only used for very high precision
+		char*       first = small + 1;
+		char*       last  = std::end(small);
+		if(m_precision > inline_digits) {
+			large.resize(1 + 20 + 1 + m_precision + P);
+			first = large.data() + 1;
+			last  = large.data() + large.size();
+		}
+		const auto r = _DA to_chars(first, last, v, m_precision);
+		DA_ASSERT(r.ec == std::errc());
+		if(*first != '-' && (m_sign == '+' || m_sign == ' ')) {
+			*--first = m_sign;
+		}
+
+		const size_t n     = static_cast<size_t>(r.ptr - first);
+		const size_t width = static_cast<size_t>(m_width);
+		auto         out   = ctx.out();
+		if(n >= width) {
+			return std::copy(first, r.ptr, out);
+		}
+		size_t left = 0, right = 0;
+		if(m_zero && m_align == 0) { // Zeros are put after the sign
+			if(*first == '-' || *first == '+' || *first == ' ') {
+				*out++ = static_cast<CharT>(*first++);
+			}
+			out = std::fill_n(out, width - n, CharT('0'));
+			return std::copy(first, r.ptr, out);
+		}
+		switch(m_align) {
+		case '<': right = width - n; break;
+		case '^':
+			left  = (width - n) / 2;
+			right = width - n - left;
+			break;
+		default: left = width - n; break; // Numbers are aligned right by default
+		}
+		out = std::fill_n(out, left, m_fill);
+		out = std::copy(first, r.ptr, out);
+		return std::fill_n(out, right, m_fill);
+	}
+
+	private:
+	template<typename It>
+	static constexpr It _S_parse_int(It it, It end, int& value) {
+		for(; it != end && *it >= CharT('0') && *it <= CharT('9'); ++it) {
+			value = value * 10 + static_cast<int>(*it - CharT('0'));
+			DA_IFUNLIKELY(value > 1000000) {
+				DA_THROW(_DAFMT format_error("da::formatter<fixed_point>::parse: Number is too big"));
+			}
+		}
+		return it;
+	}
+
+	CharT m_fill      = CharT(' ');
+	char  m_align     = 0;
+	char  m_sign      = '-';
+	bool  m_zero      = false;
+	int   m_width     = 0;
+	int   m_precision = -1;
+};
+
+/// Floating fixed_point is formatted as double
+template<size_t P, _DA floating_point B, typename CharT>
 struct _DAFMT formatter<_DA fixed_point<P, B>, CharT> : public _DAFMT formatter<double, CharT> {
 	template<typename FormatContext>
 	DA_CONSTEXPR auto format(const _DA fixed_point<P, B>& v, FormatContext& ctx) const {
@@ -262,4 +1111,13 @@ struct _DAFMT formatter<_DA fixed_point<P, B>, CharT> : public _DAFMT formatter<
 	}
 };
 
+/// binary_fixed_point is formatted as double, which is exact unless Base has more than 53 significant bits
+template<size_t F, _DA integral B, _DA overflow_policy O, typename CharT>
+struct _DAFMT formatter<_DA binary_fixed_point<F, B, O>, CharT> : public _DAFMT formatter<double, CharT> {
+	template<typename FormatContext>
+	DA_CONSTEXPR auto format(const _DA binary_fixed_point<F, B, O>& v, FormatContext& ctx) const {
+		return _DAFMT formatter<double, CharT>::format(v.template get<double>(), ctx);
+	}
+};
+
 #endif // _DA_UTILITY_NUMBER_HPP_
@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      unit-concurrency.cpp
+ * @brief     Unit test for module concurrency
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#include <da/concurrency.hpp>
+#include <da/memory.hpp>
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+struct epoch_test_tag;
+
+/// A Treiber stack, whose popped nodes are retired to an epoch_domain
+class epoch_test_stack {
+	struct node {
+		uint64_t value;
+		node*    next;
+	};
+
+	typedef da::tracking_allocator<std::allocator<node>, epoch_test_tag> allocator_type;
+
+	std::atomic<node*> m_head{nullptr};
+	da::epoch_domain&  m_domain;
+
+	public:
+	explicit epoch_test_stack(da::epoch_domain& d) noexcept
+		: m_domain(d) { }
+
+	~epoch_test_stack() {
+		for(node* p = m_head.load(); p != nullptr;) {
+			_S_free(std::exchange(p, p->next));
+		}
+	}
+
+	void push(uint64_t v) {
+		node* const n = allocator_type().allocate(1);
+		n->value      = v;
+		n->next       = m_head.load(std::memory_order_relaxed);
+		while(!m_head.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed)) { }
+	}
+
+	bool pop(uint64_t& v) {
+		auto  g    = m_domain.pin();
+		node* head = m_head.load(std::memory_order_acquire);
+		while(head != nullptr && !m_head.compare_exchange_weak(head, head->next, std::memory_order_acquire, std::memory_order_acquire)) { }
+		if(head == nullptr) {
+			return false;
+		}
+		v = head->value;
+		m_domain.retire(head, [](void* p) { _S_free(static_cast<node*>(p)); });
+		return true;
+	}
+
+	private:
+	static void _S_free(node* p) noexcept {
+		p->value = ~uint64_t(0); // Poisoned, so a use after free is seen by pop()
+		allocator_type().deallocate(p, 1);
+	}
+};
+} // namespace
+
+TEST_CASE("concurrency") {
+	SUBCASE("cache_aligned") {
+		da::cache_aligned<std::atomic<uint64_t>> a[2];
+		CHECK_EQ(sizeof(a[0]), da::destructive_interference_size);
+		CHECK_EQ(reinterpret_cast<uintptr_t>(&a[1]) % da::destructive_interference_size, 0);
+		da::cache_aligned<std::pair<int, int>> p(std::in_place, 1, 2);
+		CHECK_EQ(p->second, 2);
+		CHECK_EQ((*p).first, 1);
+	}
+
+	SUBCASE("thread_index") {
+		const uint32_t main_index = da::thread_index();
+		CHECK_EQ(da::thread_index(), main_index);
+		constexpr int            threads = 8;
+		std::vector<uint32_t>    indexes(threads);
+		std::vector<std::thread> workers;
+		std::atomic<int>         started{0};
+		for(int t = 0; t < threads; ++t) {
+			workers.emplace_back([&, t] {
+				indexes[t] = da::thread_index();
+				++started;
+				while(started.load() != threads) { } // All alive at the same time
+			});
+		}
+		for(auto& w : workers) {
+			w.join();
+		}
+		indexes.push_back(main_index);
+		CHECK_EQ(std::set<uint32_t>(indexes.begin(), indexes.end()).size(), threads + 1); // Unique
+		CHECK_LE(*std::max_element(indexes.begin(), indexes.end()), 2 * threads); // Dense
+		uint32_t reused = 0;
+		std::thread([&] { reused = da::thread_index(); }).join();
+		CHECK_NE(reused, main_index);
+		CHECK_LE(reused, *std::max_element(indexes.begin(), indexes.end()));
+	}
+
+	SUBCASE("per_thread & sharded_counter") {
+		da::per_thread<std::atomic<int>> seen;
+		da::sharded_counter              counter;
+		constexpr int                    threads = 16, n = 100000;
+		std::vector<std::thread>         workers;
+		for(int t = 0; t < threads; ++t) {
+			workers.emplace_back([&] {
+				seen.local().store(1, std::memory_order_relaxed);
+				for(int i = 0; i < n; ++i) {
+					++counter;
+				}
+				counter += 10;
+			});
+		}
+		uint64_t last      = 0;
+		bool     monotonic = true;
+		for(int i = 0; i < 100; ++i) { // Read while being updated
+			const uint64_t v = counter.load();
+			monotonic        = monotonic && v >= last;
+			last             = v;
+		}
+		for(auto& w : workers) {
+			w.join();
+		}
+		CHECK(monotonic);
+		CHECK_EQ(counter.load(), uint64_t(threads) * (n + 10)); // Exited threads are still counted
+		int total = 0;
+		seen.for_each([&](const std::atomic<int>& s) { total += s.load(); });
+		CHECK_GE(total, 1);
+		CHECK_LE(total, threads);
+		counter.add(5);
+		CHECK_EQ(counter.load(), uint64_t(threads) * (n + 10) + 5);
+	}
+
+	SUBCASE("epoch") {
+		SUBCASE("basic") {
+			da::epoch_domain d;
+			int              freed = 0;
+			auto             del   = [](void* p) { ++*static_cast<int*>(p); };
+			const uint64_t   e     = d.epoch();
+			{
+				auto g1 = d.pin();
+				auto g2 = d.pin(); // Nested
+				d.retire(&freed, del);
+				CHECK_EQ(d.pending(), 1);
+				CHECK(d.try_advance());
+				CHECK_EQ(d.epoch(), e + 1);
+				d.collect();
+				CHECK_EQ(freed, 0);
+				bool advanced = true;
+				std::thread([&] {
+					auto g   = d.pin();
+					advanced = d.try_advance(); // Blocked by the main thread pinned at e
+				}).join();
+				CHECK_FALSE(advanced);
+				CHECK_EQ(d.epoch(), e + 1);
+			}
+			d.synchronize();
+			CHECK_EQ(freed, 1);
+			CHECK_EQ(d.pending(), 0);
+			CHECK_GE(d.epoch(), e + 2);
+
+			size_t max_pending = 0;
+			for(int i = 0; i < 10000; ++i) {
+				d.retire(&freed, del);
+				max_pending = std::max(max_pending, d.pending());
+			}
+			CHECK_LE(max_pending, 3 * da::epoch_domain::batch_size); // Bounded
+			d.synchronize();
+			CHECK_EQ(freed, 10001);
+		}
+
+		SUBCASE("stress") {
+			typedef da::allocation_stats::snapshot_type snapshot_type;
+			const snapshot_type   before  = da::allocation_stats_of<epoch_test_tag>.snapshot();
+			constexpr int         threads = 8, n = 20000;
+			std::atomic<bool>     corrupted{false};
+			std::atomic<uint64_t> popped_sum{0};
+			{
+				da::epoch_domain         d;
+				epoch_test_stack         s(d);
+				std::vector<std::thread> workers;
+				for(int t = 0; t < threads; ++t) {
+					workers.emplace_back([&, t] {
+						uint64_t sum = 0;
+						for(int i = 0; i < n; ++i) {
+							s.push(uint64_t(t) * n + i);
+							uint64_t v;
+							if(s.pop(v)) {
+								corrupted = corrupted || v >= uint64_t(threads) * n;
+								sum += v;
+							}
+						}
+						popped_sum += sum;
+						d.synchronize();
+					});
+				}
+				for(auto& w : workers) {
+					w.join();
+				}
+				uint64_t v;
+				while(s.pop(v)) {
+					popped_sum += v;
+				}
+			}
+			const uint64_t total = uint64_t(threads) * n;
+			CHECK_FALSE(corrupted.load());
+			CHECK_EQ(popped_sum.load(), total * (total - 1) / 2);
+			const snapshot_type after = da::allocation_stats_of<epoch_test_tag>.snapshot();
+			CHECK_EQ(after.allocations - before.allocations, total);
+			CHECK_EQ(after.deallocations - before.deallocations, total); // Nothing leaked
+		}
+	}
+}
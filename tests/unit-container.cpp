@@ -0,0 +1,318 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      unit-container.cpp
+ * @brief     Unit test for module container
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#include <da/container.hpp>
+#include <da/memory.hpp>
+#include <da/string.hpp>
+#include <doctest/doctest.h>
+#include <span>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+// Count alive objects to detect leaks & double destruction
+struct counted {
+	static inline int alive = 0;
+	static inline int moves = 0;
+
+	int value;
+
+	counted(int v = 0)
+		: value(v) {
+		++alive;
+	}
+	counted(const counted& c)
+		: value(c.value) {
+		++alive;
+	}
+	counted(counted&& c) noexcept
+		: value(c.value) {
+		++alive;
+		++moves;
+	}
+	counted& operator=(const counted&) = default;
+	counted& operator=(counted&&)      = default;
+	~counted() {
+		--alive;
+	}
+
+	bool operator==(const counted& c) const {
+		return value == c.value;
+	}
+};
+
+// Throw from the constructor once throw_after objects are constructed
+struct thrower : counted {
+	static inline int throw_after = -1;
+
+	thrower()
+		: thrower(0) { }
+	thrower(int v)
+		: counted(v) {
+		_S_check();
+	}
+	thrower(const thrower& t)
+		: counted(t) {
+		_S_check();
+	}
+
+	static void _S_check() {
+		if(throw_after >= 0 && throw_after-- == 0) {
+			throw std::runtime_error("thrower");
+		}
+	}
+};
+
+TEST_CASE("container") {
+	SUBCASE("relocatable") {
+		CHECK(da::is_trivially_relocatable_v<int>);
+		CHECK(da::is_trivially_relocatable_v<da::string>);
+		CHECK(da::is_trivially_relocatable_v<da::sso_string>);
+		CHECK(da::is_trivially_relocatable_v<da::lazy_string>);
+		CHECK(da::is_trivially_relocatable_v<da::vector<da::string>>);
+		CHECK_FALSE(da::is_trivially_relocatable_v<counted>);
+	}
+
+	SUBCASE("vector") {
+		da::vector<int> v;
+		CHECK(v.empty());
+		for(int i = 0; i < 100; ++i) {
+			v.push_back(i);
+		}
+		CHECK_EQ(v.size(), 100);
+		CHECK_GE(v.capacity(), 100);
+		CHECK_EQ(v.front(), 0);
+		CHECK_EQ(v.back(), 99);
+		CHECK_EQ(v.at(42), 42);
+		CHECK_THROWS_AS((void)v.at(100), std::out_of_range);
+
+		v.erase(v.begin() + 10, v.begin() + 90);
+		CHECK_EQ(v.size(), 20);
+		CHECK_EQ(v[10], 90);
+		v.insert(v.begin() + 1, {-1, -2, -3});
+		CHECK_EQ(v, da::vector<int>{0, -1, -2, -3, 1, 2, 3, 4, 5, 6, 7, 8, 9, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99});
+		v.insert(v.begin(), 3, v[1]); // Refer to an element to be moved
+		CHECK_EQ(v[0], -1);
+		CHECK_EQ(v[2], -1);
+		CHECK_EQ(v[3], 0);
+		CHECK_EQ(da::erase(v, -1), 4);
+		CHECK_EQ(da::erase_if(v, [](int x) { return x >= 90; }), 10);
+		CHECK_EQ(v, da::vector<int>{0, -2, -3, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+		v.resize(3);
+		CHECK_EQ(v, da::vector<int>{0, -2, -3});
+		v.resize(5, 7);
+		CHECK_EQ(v, da::vector<int>{0, -2, -3, 7, 7});
+		v.shrink_to_fit();
+		CHECK_EQ(v.capacity(), 5);
+		CHECK_LT(v, da::vector<int>{0, -1});
+
+		da::vector<int> w(std::move(v));
+		CHECK(v.empty());
+		CHECK_EQ(w.size(), 5);
+		v = w;
+		CHECK_EQ(v, w);
+		v.clear();
+		CHECK(v.empty());
+	}
+
+	SUBCASE("vector of string") {
+		da::vector<da::string>  v;
+		std::vector<const char*> data;
+		for(int i = 0; i < 1000; ++i) {
+			v.emplace_back(100, static_cast<char>('a' + i % 26));
+			data.push_back(v.back().data());
+		}
+		// Relocated by memcpy, so the heap buffers are never reallocated
+		for(size_t i = 0; i < v.size(); ++i) {
+			CHECK_EQ(v[i].data(), data[i]);
+			CHECK_EQ(std::string_view(v[i]), std::string(100, static_cast<char>('a' + i % 26)));
+		}
+		v.erase(v.begin());
+		v.emplace(v.begin() + 1, "inserted");
+		v.emplace(v.begin(), v[2]); // Refer to an element to be moved
+		CHECK_EQ(std::string_view(v[0]), std::string(100, 'c'));
+		CHECK_EQ(std::string_view(v[2]), "inserted"sv);
+		CHECK_EQ(v.size(), 1001);
+
+		da::vector<da::sso_string> s(3, "short");
+		s.insert(s.begin() + 1, "middle");
+		s.reserve(100);
+		CHECK_EQ(std::string_view(s[0]), "short"sv);
+		CHECK_EQ(std::string_view(s[1]), "middle"sv);
+		CHECK_EQ(std::string_view(s[3]), "short"sv);
+	}
+
+	SUBCASE("vector of non-relocatable") {
+		{
+			da::vector<counted> v;
+			for(int i = 0; i < 100; ++i) {
+				v.emplace_back(i);
+			}
+			CHECK_GT(counted::moves, 0); // Moved one by one on growth
+			v.insert(v.begin() + 50, 3, counted(-1));
+			v.emplace(v.begin(), v[10]);
+			CHECK_EQ(v[0].value, 10);
+			CHECK_EQ(v[51].value, -1);
+			CHECK_EQ(v[54].value, 50);
+			v.erase(v.begin() + 1, v.begin() + 60);
+			CHECK_EQ(v.size(), 45);
+			CHECK_EQ(v[1].value, 56);
+			CHECK_EQ(counted::alive, 45);
+		}
+		CHECK_EQ(counted::alive, 0);
+	}
+
+	SUBCASE("vector constructors throwing") {
+		struct tag;
+		typedef da::tracking_allocator<std::allocator<thrower>, tag> alloc;
+		typedef da::vector<thrower, alloc>                           vector;
+
+		const thrower t(1);
+		const vector  v(4, t);
+		const thrower a[4] = {1, 2, 3, 4};
+		thrower::throw_after = 2;
+		CHECK_THROWS_AS(vector(5), std::runtime_error);
+		thrower::throw_after = 2;
+		CHECK_THROWS_AS(vector(5, t), std::runtime_error);
+		thrower::throw_after = 2;
+		CHECK_THROWS_AS(vector(std::begin(a), std::end(a)), std::runtime_error);
+		thrower::throw_after = 2;
+		CHECK_THROWS_AS((vector(v)), std::runtime_error);
+		thrower::throw_after = 2;
+		CHECK_THROWS_AS((da::small_vector<thrower, 8>(5)), std::runtime_error); // Inline
+		thrower::throw_after = -1;
+		CHECK_EQ(counted::alive, 9);
+		const auto stats = alloc::stats().snapshot();
+		CHECK_EQ(stats.allocations, stats.deallocations + 1); // Only v is alive
+	}
+
+	SUBCASE("small_vector") {
+		auto is_inline = [](const auto& c) {
+			const void* p = c.data();
+			return p >= static_cast<const void*>(&c) && p < static_cast<const void*>(&c + 1);
+		};
+
+		da::small_vector<int, 8> v;
+		CHECK_EQ(v.capacity(), 8);
+		for(int i = 0; i < 8; ++i) {
+			v.push_back(i);
+		}
+		CHECK(is_inline(v));
+		v.insert(v.begin(), {-2, -1}); // Spill to the heap
+		CHECK_FALSE(is_inline(v));
+		CHECK_EQ(v, da::small_vector<int, 8>{-2, -1, 0, 1, 2, 3, 4, 5, 6, 7});
+		const int* const heap = v.data();
+		da::small_vector<int, 8> w(std::move(v)); // Steal the heap buffer
+		CHECK_EQ(static_cast<const void*>(w.data()), static_cast<const void*>(heap));
+		CHECK(v.empty());
+		CHECK(is_inline(v));
+		w.resize(3);
+		w.shrink_to_fit(); // Back inline
+		CHECK(is_inline(w));
+		CHECK_EQ(w, da::small_vector<int, 8>{-2, -1, 0});
+		CHECK_EQ(da::erase(w, -1), 1);
+		CHECK_LT(w, da::small_vector<int, 8>{-2, 1});
+
+		// Growing again after shrinking back inline
+		da::small_vector<std::string, 8> g;
+		for(int i = 0; i < 10; ++i) {
+			g.push_back(std::to_string(i));
+		}
+		g.resize(2);
+		g.shrink_to_fit();
+		CHECK(is_inline(g));
+		CHECK_EQ(g.capacity(), 8);
+		for(int i = 2; i < 8; ++i) {
+			g.push_back(std::to_string(i));
+		}
+		CHECK(is_inline(g));
+		g.push_back("8");
+		CHECK_FALSE(is_inline(g));
+		CHECK_EQ(g.size(), 9);
+		CHECK_EQ(g[8], "8");
+
+		// Inline elements are relocated on move, by memcpy for da::string
+		da::small_vector<da::string, 4> s;
+		s.emplace_back(100, 'a');
+		s.emplace_back("short");
+		const char* const data = s[0].data();
+		da::small_vector<da::string, 4> t(std::move(s));
+		CHECK_EQ(t[0].data(), data);
+		CHECK_EQ(std::string_view(t[1]), "short"sv);
+		CHECK(s.empty());
+
+		{
+			da::small_vector<counted, 4> a, b;
+			for(int i = 0; i < 3; ++i) {
+				a.emplace_back(i);
+			}
+			for(int i = 0; i < 10; ++i) {
+				b.emplace_back(-i);
+			}
+			a.swap(b); // Inline & heap
+			CHECK_EQ(a.size(), 10);
+			CHECK_EQ(b.size(), 3);
+			CHECK_EQ(a[9].value, -9);
+			CHECK_EQ(b[2].value, 2);
+			CHECK(is_inline(b));
+			b = a;
+			CHECK_EQ(b, a);
+			a.erase(a.begin() + 2, a.end());
+			a = std::move(b);
+			CHECK_EQ(a.size(), 10);
+			CHECK_EQ(counted::alive, 10);
+		}
+		CHECK_EQ(counted::alive, 0);
+	}
+
+	SUBCASE("fixed_point_column") {
+		using f4 = da::fixed_point<4>;
+		da::fixed_point_column<4> c;
+		std::vector<f4>           v;
+		constexpr size_t          n = da::fixed_point_column<4>::block_size;
+		// One block of each width: constant, 1, 2, 4 & 8 bytes, and a tail
+		auto value = [](size_t i) {
+			const int64_t base  = static_cast<int64_t>(i / n) * 1000000 - 3000000;
+			const int64_t range = i < n ? 0 : int64_t(1) << (8 * (int64_t(1) << std::min<size_t>(i / n - 1, 3)) - 2);
+			return range == 0 ? base : base + static_cast<int64_t>((i * 0x9E3779B97F4A7C15) % static_cast<uint64_t>(range));
+		};
+		for(size_t i = 0; i < 5 * n + 100; ++i) {
+			// Pairs of opposite numbers since the 8-byte block, so that the sum still fits
+			v.push_back(f4::from_raw(i / n < 4 ? value(i) : i % 2 == 0 ? value(i) : -value(i - 1)));
+			c.push_back(v.back());
+		}
+		CHECK_EQ(c.size(), v.size());
+		CHECK_LT(c.memory_usage(), v.size() * sizeof(f4));
+		for(size_t i = 0; i < v.size(); ++i) {
+			CHECK_EQ(c[i], v[i]);
+		}
+		CHECK_EQ(c.at(5 * n), v[5 * n]);
+		CHECK_THROWS_AS((void)c.at(v.size()), std::out_of_range);
+
+		CHECK_EQ(c.sum(), da::sum(std::span<const f4>(v)));
+		CHECK_EQ(c.min(), da::min(std::span<const f4>(v)));
+		CHECK_EQ(c.max(), da::max(std::span<const f4>(v)));
+		size_t i = 0;
+		c.scan([&](std::span<const f4> s) {
+			for(f4 x : s) {
+				CHECK_EQ(x, v[i++]);
+			}
+		});
+		CHECK_EQ(i, v.size());
+
+		da::fixed_point_column<2, int32_t> d{1, 2.5, -3};
+		CHECK_EQ(d.sum(), 0.5);
+		CHECK_EQ(d.min(), -3);
+		c.clear();
+		CHECK(c.empty());
+	}
+}
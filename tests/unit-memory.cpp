@@ -0,0 +1,385 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      unit-memory.cpp
+ * @brief     Unit test for module memory
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#include <da/container.hpp>
+#include <da/memory.hpp>
+#include <da/string.hpp>
+#include <doctest/doctest.h>
+#include <atomic>
+#include <bit>
+#include <filesystem>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+// Count alive objects to detect leaks, over-aligned to check the slots
+struct alignas(32) session {
+	static inline std::atomic<int> alive = 0;
+
+	int id;
+
+	explicit session(int i)
+		: id(i) {
+		if(i < 0) {
+			throw std::invalid_argument("negative id");
+		}
+		++alive;
+	}
+	~session() {
+		--alive;
+	}
+};
+
+TEST_CASE("memory") {
+	SUBCASE("arena") {
+		alignas(std::max_align_t) char buf[256];
+		da::arena                       a(buf, sizeof(buf), 1024);
+
+		// From the initial buffer first, aligned as requested
+		void* const p = a.allocate(10, 1);
+		CHECK_EQ(p, static_cast<void*>(buf));
+		auto* const q = static_cast<char*>(a.allocate(8, 8));
+		CHECK_EQ(static_cast<void*>(q), static_cast<void*>(buf + 16));
+		a.deallocate(q, 8); // The last allocation is reclaimed
+		CHECK_EQ(a.allocate(8, 8), static_cast<void*>(q));
+
+		// Then from the blocks, including allocations larger than a block
+		char* const r = static_cast<char*>(a.allocate(300));
+		CHECK_FALSE((r >= buf && r < buf + sizeof(buf)));
+		char* const big = static_cast<char*>(a.allocate(10000, 64));
+		CHECK_EQ(reinterpret_cast<uintptr_t>(big) % 64, 0);
+		std::fill(big, big + 10000, 'x');
+
+		struct node {
+			int   value;
+			node* next;
+		};
+		node* head = nullptr;
+		for(int i = 0; i < 1000; ++i) {
+			head = a.create<node>(i, head);
+		}
+		int sum = 0;
+		for(node* n = head; n != nullptr; n = n->next) {
+			sum += n->value;
+		}
+		CHECK_EQ(sum, 999 * 1000 / 2);
+
+		a.reset();
+		CHECK_EQ(a.allocate(10, 1), static_cast<void*>(buf));
+		a.release();
+		CHECK_EQ(a.allocate(10, 1), static_cast<void*>(buf));
+
+		da::arena b; // No initial buffer
+		CHECK_NE(b.allocate(1), nullptr);
+		CHECK_THROWS_AS((void)b.allocate(std::numeric_limits<size_t>::max() - 8), std::bad_alloc);
+	}
+
+	SUBCASE("arena_allocator") {
+		alignas(std::max_align_t) char buf[1024];
+		da::arena                       a(buf, sizeof(buf));
+
+		typedef da::arena_allocator<char> alloc;
+		typedef da::string_base<char, std::char_traits<char>, alloc, da::normal_string_base> arena_string;
+		typedef da::string_base<char, std::char_traits<char>, alloc, da::sso_string_base>    arena_sso_string;
+
+		arena_string s("hello", a);
+		CHECK((s.data() >= buf && s.data() < buf + sizeof(buf)));
+		for(int i = 0; i < 100; ++i) {
+			s += ", hello";
+		}
+		CHECK_EQ(s.size(), 5 + 7 * 100);
+		CHECK(s.get_allocator() == alloc(a));
+
+		arena_string t(s); // The copy uses the same arena
+		CHECK(t.get_allocator() == alloc(a));
+		CHECK_EQ(std::string_view(t), std::string_view(s));
+		arena_string u(std::move(t));
+		CHECK_EQ(std::string_view(u), std::string_view(s));
+
+		arena_sso_string v(std::string_view(s).substr(0, 5).data(), 5, a);
+		CHECK_EQ(std::string_view(v), "hello"sv);
+		v.append(100, '!');
+		CHECK_EQ(v.size(), 105);
+
+		da::vector<int, da::arena_allocator<int>> w(a);
+		for(int i = 0; i < 1000; ++i) {
+			w.push_back(i);
+		}
+		CHECK_EQ(w[999], 999);
+		CHECK(w.get_allocator() == da::arena_allocator<long>(a));
+
+		da::arena other;
+		CHECK(alloc(a) != alloc(other));
+		arena_string x("moved from another arena", other);
+		u = std::move(x); // Copied, since the memory of other is freed with other
+		CHECK(u.get_allocator() == alloc(a));
+		other.release();
+		CHECK_EQ(std::string_view(u), "moved from another arena"sv);
+	}
+
+	SUBCASE("aligned_buffer") {
+		da::aligned_buffer<double> b(nullptr);
+		*b.ptr() = 1.5;
+		CHECK_EQ(*static_cast<const da::aligned_buffer<double>&>(b).ptr(), 1.5);
+		CHECK_EQ(b.addr(), static_cast<void*>(b.ptr()));
+	}
+
+	SUBCASE("object_pool") {
+		da::object_pool<session> pool;
+		std::vector<session*>    v;
+		for(int i = 0; i < 100; ++i) {
+			v.push_back(pool.construct(i));
+			CHECK_EQ(reinterpret_cast<uintptr_t>(v.back()) % 32, 0);
+		}
+		CHECK_EQ(session::alive, 100);
+		CHECK_EQ(pool.capacity(), 32 + 64 + 128); // Chunks doubled
+		session* const last = v.back();
+		for(session* p : v) {
+			pool.destroy(p);
+		}
+		CHECK_EQ(session::alive, 0);
+		CHECK_EQ(pool.construct(7), last); // Reused from the free list, the latest first
+		CHECK_THROWS_AS((void)pool.construct(-1), std::invalid_argument);
+		CHECK_EQ(pool.capacity(), 32 + 64 + 128);
+		pool.destroy(last);
+		pool.destroy(nullptr);
+
+		// Shared by threads, each with its own cache
+		da::object_pool<session, std::mutex> shared;
+		constexpr int                        threads = 4;
+		std::vector<std::thread>             workers;
+		std::vector<int>                     wrong(threads);
+		for(int t = 0; t < threads; ++t) {
+			workers.emplace_back([&, t] {
+				da::object_pool<session, std::mutex>::local_cache cache(shared);
+				std::vector<session*>                             mine;
+				for(int round = 0; round < 100; ++round) {
+					for(int i = 0; i < 50; ++i) {
+						mine.push_back(cache.construct(t * 1000 + i));
+					}
+					for(int i = 0; i < 50; ++i) {
+						wrong[t] += mine[i]->id != t * 1000 + i;
+						// Either the cache or the pool may destroy it
+						i % 2 == 0 ? cache.destroy(mine[i]) : shared.destroy(mine[i]);
+					}
+					mine.clear();
+				}
+			});
+		}
+		for(auto& w : workers) {
+			w.join();
+		}
+		CHECK_EQ(wrong, std::vector<int>(threads));
+		CHECK_EQ(session::alive, 0);
+		CHECK_LE(shared.capacity(), 4 * (50 + 2 * 32) + 4096);
+	}
+
+	SUBCASE("pool_allocator") {
+		// The same class of 32 bytes, reused at once
+		void* const p = da::pool_allocate(24);
+		da::pool_deallocate(p, 24);
+		void* const q = da::pool_allocate(32);
+		CHECK_EQ(q, p);
+		CHECK_EQ(reinterpret_cast<uintptr_t>(q) % alignof(std::max_align_t), 0);
+		da::pool_deallocate(q, 32);
+		// Larger or over-aligned memory goes to ::operator new
+		void* const big = da::pool_allocate(1000);
+		da::pool_deallocate(big, 1000);
+		void* const aligned = da::pool_allocate(64, 64);
+		CHECK_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+		da::pool_deallocate(aligned, 64, 64);
+
+		typedef da::string_base<char, std::char_traits<char>, da::pool_allocator<char>, da::normal_string_base> pool_string;
+		static_assert(sizeof(pool_string) == sizeof(da::string)); // Stateless
+
+		// Each thread allocates strings & hands them to the next thread to check & free
+		constexpr int                         threads = 4, n = 20000;
+		std::vector<std::vector<pool_string>> made(threads);
+		std::vector<int>                      wrong(threads);
+
+		auto text = [](int t, int i) {
+			return std::string(static_cast<size_t>(i % 200), static_cast<char>('a' + t)) + std::to_string(i);
+		};
+		std::vector<std::thread> workers;
+		for(int t = 0; t < threads; ++t) {
+			workers.emplace_back([&, t] {
+				for(int i = 0; i < n; ++i) {
+					const std::string s = text(t, i);
+					made[t].emplace_back(s.data(), s.size());
+				}
+			});
+		}
+		for(auto& w : workers) {
+			w.join();
+		}
+		workers.clear();
+		for(int t = 0; t < threads; ++t) {
+			workers.emplace_back([&, t] {
+				const int from = (t + 1) % threads;
+				for(int i = 0; i < n; ++i) {
+					wrong[t] += std::string_view(made[from][i]) != text(from, i);
+				}
+				made[from].clear(); // Freed by another thread
+				std::vector<pool_string> mine;
+				for(int i = 0; i < n; ++i) { // Reusing the blocks
+					mine.emplace_back(static_cast<size_t>(i % 100), 'x');
+				}
+				for(int i = 0; i < n; ++i) {
+					wrong[t] += mine[i].size() != static_cast<size_t>(i % 100);
+				}
+			});
+		}
+		for(auto& w : workers) {
+			w.join();
+		}
+		CHECK_EQ(wrong, std::vector<int>(threads));
+	}
+
+	SUBCASE("tracking_allocator") {
+		struct strings_tag;
+		typedef da::string_base<char, std::char_traits<char>, da::tracking_allocator<std::allocator<char>, strings_tag>, da::sso_string_base> tracked_string;
+		const da::allocation_stats& stats = da::allocation_stats_of<strings_tag>;
+		static_assert(sizeof(tracked_string) == sizeof(da::string));
+		{
+			tracked_string short_string("short");
+			CHECK_EQ(stats.snapshot().allocations, 0); // Saved by SSO
+			tracked_string long_string(100, 'x');
+			tracked_string copy(long_string);
+			const auto     s = stats.snapshot();
+			CHECK_EQ(s.allocations, 2);
+			CHECK_GE(s.bytes_in_use, 202);
+			CHECK_EQ(s.histogram[std::bit_width(s.bytes_in_use / 2)], 2);
+		}
+		auto s = stats.snapshot();
+		CHECK_EQ(s.deallocations, 2);
+		CHECK_EQ(s.bytes_in_use, 0);
+		CHECK_EQ(s.peak_bytes, s.allocated_bytes);
+
+		// Rebound by containers, and counted by threads separately
+		struct vectors_tag;
+		constexpr int threads = 4, n = 1000;
+		std::vector<std::thread> workers;
+		for(int t = 0; t < threads; ++t) {
+			workers.emplace_back([] {
+				da::vector<int, da::tracking_allocator<std::allocator<int>, vectors_tag>> v;
+				for(int i = 0; i < n; ++i) {
+					v.reserve(v.size() + 1); // Exactly one allocation each time
+					v.push_back(i);
+				}
+			});
+		}
+		for(auto& w : workers) {
+			w.join();
+		}
+		s = da::tracking_allocator<std::allocator<int>, vectors_tag>::stats().snapshot();
+		CHECK_EQ(s.allocations, threads * n);
+		CHECK_EQ(s.deallocations, threads * n);
+		CHECK_EQ(s.allocated_bytes, threads * sizeof(int) * n * (n + 1) / 2);
+		CHECK_EQ(s.bytes_in_use, 0);
+		CHECK_GE(s.peak_bytes, sizeof(int) * n);
+
+		// Freed by threads without counters, one never allocating & one destroying a thread-local object
+		// after its counters are detached
+		struct exit_tag;
+		typedef da::tracking_allocator<std::allocator<int>, exit_tag> exit_allocator;
+		exit_allocator                                                a;
+		int* const                                                    p = a.allocate(100);
+		std::thread([&] { a.deallocate(p, 100); }).join();
+		std::thread([] {
+			thread_local da::vector<int, exit_allocator> late; // Constructed before the counters, so destroyed after
+			late.resize(100);
+		}).join();
+		s = exit_allocator::stats().snapshot();
+		CHECK_EQ(s.allocations, 2);
+		CHECK_EQ(s.deallocations, 2);
+		CHECK_EQ(s.bytes_in_use, 0);
+		CHECK_GE(s.peak_bytes, sizeof(int) * 100);
+	}
+
+#if DA_UNIX
+	SUBCASE("page_allocator") {
+		void* const p = da::map_pages(100);
+		CHECK_EQ(reinterpret_cast<uintptr_t>(p) % da::page_size(), 0);
+		CHECK_EQ(static_cast<const char*>(p)[99], 0); // Zeroed
+		da::unmap_pages(p, 100);
+		for(auto kind : {da::page_kind::transparent_huge, da::page_kind::huge}) { // huge falls back if none is reserved
+			char* const h = static_cast<char*>(da::map_pages(3 * da::huge_page_size + 1, kind));
+			CHECK_EQ(reinterpret_cast<uintptr_t>(h) % da::huge_page_size, 0);
+			h[0] = h[3 * da::huge_page_size] = 1;
+			da::unmap_pages(h, 3 * da::huge_page_size + 1, kind);
+		}
+
+		typedef da::string_base<char, std::char_traits<char>, da::huge_page_allocator<char>, da::normal_string_base> huge_string;
+		huge_string s{da::huge_page_allocator<char>(true)};
+		for(int i = 0; i < 1000; ++i) { // Small, then huge
+			s.append(5000, static_cast<char>('a' + i % 26));
+		}
+		CHECK_EQ(s.size(), 5000000);
+		CHECK_EQ(s[4999999], static_cast<char>('a' + 999 % 26));
+		da::vector<int, da::page_allocator<int>> v(1000, 7);
+		CHECK_EQ(reinterpret_cast<uintptr_t>(v.data()) % da::page_size(), 0);
+		v.resize(100000, 8);
+		CHECK_EQ(v[999], 7);
+		CHECK_EQ(v[1000], 8);
+	}
+
+	SUBCASE("mapped_file") {
+		const auto path = std::filesystem::temp_directory_path() / "da-unit-mapped_file.bin";
+		std::filesystem::remove(path);
+		{
+			auto f = da::mapped_file::open(path, da::mapped_file::open_mode::read_write); // Created
+			CHECK(f.is_open());
+			CHECK(f.empty());
+			f.resize(1000 * sizeof(uint32_t));
+			auto v = f.as_writable_span<uint32_t>();
+			CHECK_EQ(v.size(), 1000);
+			CHECK_EQ(v[999], 0);
+			for(uint32_t i = 0; i < 1000; ++i) {
+				v[i] = i * i;
+			}
+			f.resize(2000 * sizeof(uint32_t)); // Grown, may be moved
+			CHECK_EQ(f.as_span<uint32_t>()[999], 999 * 999);
+			CHECK_EQ(f.as_span<uint32_t>()[1999], 0);
+			f.sync();
+		}
+		CHECK_EQ(std::filesystem::file_size(path), 2000 * sizeof(uint32_t));
+		{
+			using enum da::mapped_file::open_mode;
+			da::mapped_file f = da::mapped_file::open(path, populate);
+			CHECK_FALSE(f.writable());
+			f.advise(da::mapped_file::access_hint::random | da::mapped_file::access_hint::willneed);
+			const std::span<const uint32_t> v = f.as_span<uint32_t>();
+			CHECK_EQ(v.size(), 2000);
+			CHECK_EQ(v[123], 123 * 123);
+			da::mapped_file g(std::move(f));
+			CHECK_FALSE(f.is_open());
+			CHECK_EQ(static_cast<const void*>(g.data()), static_cast<const void*>(v.data()));
+			g.advise(da::mapped_file::access_hint::dontneed); // Reloaded from the file
+			CHECK_EQ(g.as_span<uint32_t>()[1000 - 1], 999 * 999);
+
+			da::mapped_file w = da::mapped_file::open(path, read_write | populate);
+			w.resize(10);
+			CHECK_EQ(std::filesystem::file_size(path), 10);
+			w.resize(0);
+			w.close();
+			CHECK_FALSE(w.is_open());
+
+			const da::mapped_file e = da::mapped_file::open(path); // Empty, nothing mapped
+			CHECK(e.is_open());
+			CHECK(e.empty());
+			CHECK_EQ(e.data(), nullptr);
+		}
+		std::filesystem::remove(path);
+		CHECK_THROWS_AS((void)da::mapped_file::open(path), std::system_error);
+	}
+#endif
+}
@@ -0,0 +1,366 @@
+/* SPDX-License-Identifier: MIT */
+/**
+ * @file      unit-string.cpp
+ * @brief     Unit test for module string
+ * @version   0.2
+ * @author    dragon-archer
+ *
+ * @copyright Copyright (c) 2023 dragon-archer
+ */
+
+#include <da/string.hpp>
+#include <doctest/doctest.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+template<typename Range>
+std::vector<std::string_view> collect(Range&& r) {
+	std::vector<std::string_view> ret;
+	for(auto s : r) {
+		ret.push_back(s);
+	}
+	return ret;
+}
+
+TEST_CASE("string") {
+	SUBCASE("push_back") {
+		da::string      s;
+		da::sso_string  t;
+		da::lazy_string l;
+		for(int i = 0; i < 100; ++i) {
+			s.push_back(static_cast<char>('a' + i % 26));
+			t.push_back(static_cast<char>('a' + i % 26));
+			l.push_back(static_cast<char>('a' + i % 26));
+		}
+		CHECK_EQ(s.size(), 100);
+		CHECK_EQ(t.size(), 100);
+		CHECK_EQ(l.size(), 100);
+		CHECK_EQ(std::string_view(s), std::string_view(t));
+		CHECK_EQ(std::string_view(s), std::string_view(l));
+		CHECK_EQ(std::char_traits<char>::length(s.c_str()), 100);
+		CHECK_EQ(std::char_traits<char>::length(l.c_str()), 100); // Terminator is written by c_str()
+	}
+
+	SUBCASE("sso_string sizes") {
+		for(size_t n : {0, 22, 23, 127, 128, 200, 255, 256, 1000}) { // Around SSO & the low byte of the size
+			da::sso_string s(n, 'x');
+			CHECK_EQ(s.size(), n);
+			CHECK_EQ(std::string_view(s), std::string(n, 'x'));
+		}
+		da::sso_string s(200, 'y'); // On the heap, its size used to be taken for an SSO one
+		CHECK_GE(s.capacity(), 200);
+		s.push_back('z');
+		CHECK_EQ(s.size(), 201);
+		CHECK_EQ(std::string_view(s), std::string(200, 'y') + "z");
+	}
+
+	SUBCASE("resize_and_overwrite") {
+		da::sso_string s("ab");
+		s.resize_and_overwrite(40, [](char* p, size_t n) {
+			std::fill(p + 2, p + n, 'c');
+			return n - 1;
+		});
+		CHECK_EQ(std::string_view(s), "ab" + std::string(37, 'c'));
+		CHECK_EQ(s.c_str()[39], '\0');
+	}
+
+	SUBCASE("number") {
+		CHECK_EQ(std::string_view(da::to_string(0)), "0"sv);
+		CHECK_EQ(std::string_view(da::to_string(-42)), "-42"sv);
+		CHECK_EQ(std::string_view(da::to_string(std::numeric_limits<int64_t>::min())), "-9223372036854775808"sv);
+		CHECK_EQ(std::string_view(da::to_string(~uint64_t(0))), "18446744073709551615"sv);
+		CHECK_EQ(std::string_view(da::to_string(0.1)), "0.1"sv);
+		CHECK_EQ(std::string_view(da::to_string(-1e300)), "-1e+300"sv);
+		CHECK_EQ(std::string_view(da::to_string<da::sso_string>(da::fixed_point<3>::from_raw(-5))), "-0.005"sv);
+
+		da::lazy_string l;
+		for(int i = 0; i < 1000; ++i) {
+			da::append_number(l, i * 1001);
+			l.push_back(',');
+		}
+		uint64_t sum = 0;
+		for(auto t : da::split(std::string_view(l), ',')) {
+			if(!t.empty()) {
+				sum += da::parse<uint64_t>(t);
+			}
+		}
+		CHECK_EQ(sum, 1001ull * 999 * 1000 / 2);
+
+		CHECK_EQ(da::parse<int>("-2147483648"), std::numeric_limits<int>::min());
+		CHECK_EQ(da::parse<uint64_t>("0000000000000000000000018446744073709551615"), ~uint64_t(0));
+		CHECK_EQ(da::parse<double>("2.5e-3"), 2.5e-3);
+		CHECK_EQ(da::parse<da::fixed_point<2>>("-1.25"), da::fixed_point<2>(-1.25));
+		CHECK_THROWS_AS((void)da::parse<uint64_t>("18446744073709551616"), std::out_of_range);
+		CHECK_THROWS_AS((void)da::parse<int8_t>("128"), std::out_of_range);
+		CHECK_THROWS_AS((void)da::parse<unsigned>("-1"), std::invalid_argument);
+		CHECK_THROWS_AS((void)da::parse<int>("12345678x"), std::invalid_argument);
+		CHECK_THROWS_AS((void)da::parse<int>(""), std::invalid_argument);
+	}
+
+	SUBCASE("encoding") {
+		auto hex = [](std::string_view s, bool upper = false) {
+			da::string r;
+			da::hex_encode(r, s, upper);
+			return std::string(r);
+		};
+		auto base64 = [](std::string_view s) {
+			da::string r;
+			da::base64_encode(r, s);
+			return std::string(r);
+		};
+		CHECK_EQ(hex(""), "");
+		CHECK_EQ(hex("\x12\xAB\xff"sv), "12abff");
+		CHECK_EQ(hex("\x12\xAB\xff"sv, true), "12ABFF");
+		const char* const vectors[][2] = {
+			{"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"}};
+		for(auto [s, e] : vectors) {
+			CHECK_EQ(base64(s), e);
+		}
+		// Long enough to go through the SIMD paths
+		std::string s, e;
+		for(int i = 0; i < 40; ++i) {
+			s += "foobar";
+			e += "Zm9vYmFy";
+		}
+		CHECK_EQ(base64(s), e);
+		CHECK_EQ(base64("\xfb\xff\xbf"sv), "+/+/");
+		CHECK_EQ(base64(std::string(60, '\xff')), std::string(80, '/'));
+
+		std::string bytes;
+		uint32_t    seed = 1;
+		for(int i = 0; i < 300; ++i) {
+			seed = seed * 1103515245 + 12345;
+			bytes.push_back(static_cast<char>(seed >> 16));
+		}
+		for(size_t n = 0; n <= bytes.size(); n += n < 80 ? 1 : 37) {
+			const std::string_view b(bytes.data(), n);
+			std::string            h;
+			for(char c : b) {
+				h += fmt::format("{:02x}", static_cast<unsigned char>(c));
+			}
+			CHECK_EQ(hex(b), h);
+			da::string d("x");
+			CHECK(da::hex_decode(d, h));
+			CHECK_EQ(std::string_view(d), "x" + std::string(b));
+
+			const std::string e64 = base64(b);
+			CHECK_EQ(e64.size(), da::base64_encoded_size(n));
+			CHECK_EQ(da::base64_decoded_size(e64), n);
+			da::sso_string d64;
+			CHECK(da::base64_decode(d64, e64));
+			CHECK_EQ(std::string_view(d64), b);
+		}
+
+		// The position of the first invalid character, wherever it is
+		const std::string h   = hex(bytes);
+		const std::string e64 = base64(bytes.substr(0, 299));
+		for(size_t i = 0; i < h.size(); i += 7) {
+			std::string t = h;
+			t[i]          = i % 2 == 0 ? 'g' : '\x80';
+			da::string d("x");
+			const auto r = da::hex_decode(d, t);
+			CHECK_FALSE(r);
+			CHECK_EQ(r.position, i);
+			CHECK_EQ(std::string_view(d), "x"); // Unchanged on failure
+		}
+		for(size_t i = 0; i < e64.size(); i += 5) {
+			std::string t = e64;
+			t[i]          = i % 2 == 0 ? '=' : '-';
+			da::string d;
+			const auto r = da::base64_decode(d, t);
+			CHECK_FALSE(r);
+			CHECK_EQ(r.position, i);
+			CHECK(d.empty());
+		}
+		da::string d;
+		CHECK_EQ(da::hex_decode(d, "abc").position, 3);
+		CHECK_EQ(da::base64_decode(d, "Zm9").position, 3);
+		CHECK_EQ(da::base64_decode(d, "Zg=a").position, 2);
+		CHECK_EQ(da::base64_decode(d, "=g==").position, 0);
+		CHECK_EQ(da::base64_decode(d, "Zm9v====").position, 4);
+
+		CHECK(da::is_ascii("hello, world! 0123456789 hello, world!"));
+		CHECK_FALSE(da::is_ascii("hello, world! 0123456789 hello, world\x80"));
+		CHECK_FALSE(da::is_ascii("\xe4\xbd\xa0\xe5\xa5\xbd, world! 0123456789 hello, world"));
+
+		// The scalar fallbacks are constexpr
+		static_assert([] {
+			char out[8]{};
+			da::detail::encode_base64("foob", 4, out);
+			char back[4]{};
+			return std::string_view(out, 8) == "Zm9vYg==" && da::detail::decode_base64(out, 8, back) == 8 && back[3] == 'b';
+		}());
+		static_assert([] {
+			char out[4]{};
+			da::detail::encode_hex("\x1f\xa0", 2, out, false);
+			char back[2]{};
+			return std::string_view(out, 4) == "1fa0" && da::detail::decode_hex("1FA0", 4, back) == 4 && back[1] == '\xa0';
+		}());
+	}
+
+	SUBCASE("split") {
+		using v = std::vector<std::string_view>;
+		SUBCASE("char") {
+			CHECK_EQ(collect(da::split("a,b,c"sv, ',')), v{"a", "b", "c"});
+			CHECK_EQ(collect(da::split("a,,b,"sv, ',')), v{"a", "", "b", ""});
+			CHECK_EQ(collect(da::split(""sv, ',')), v{""});
+			CHECK_EQ(collect(da::split("abc"sv, ',')), v{"abc"});
+			// Long enough to go through the SIMD path
+			CHECK_EQ(collect(da::split("0123456789abcdefghij/0123456789abcdefghij/x"sv, '/')),
+					 v{"0123456789abcdefghij", "0123456789abcdefghij", "x"});
+		}
+		SUBCASE("string") {
+			CHECK_EQ(collect(da::split("a::b::::c"sv, "::")), v{"a", "b", "", "c"});
+			CHECK_EQ(collect(da::split("a::b"sv, "")), v{"a::b"});
+		}
+		SUBCASE("any") {
+			CHECK_EQ(collect(da::split_any("k1=v1&k2=v2"sv, "=&")), v{"k1", "v1", "k2", "v2"});
+		}
+		SUBCASE("lines") {
+			CHECK_EQ(collect(da::split_lines("a\nb\r\n\nc\n"sv)), v{"a", "b", "", "c"});
+			CHECK_EQ(collect(da::split_lines("a"sv)), v{"a"});
+			CHECK(collect(da::split_lines(""sv)).empty());
+		}
+		SUBCASE("string_base") {
+			const da::string s("usr/local/bin");
+			const auto       r = collect(da::split(s, '/'));
+			CHECK_EQ(r, v{"usr", "local", "bin"});
+			CHECK_EQ(r[0].data(), s.data()); // No copy
+			const std::string t("x y");
+			CHECK_EQ(collect(da::split(t, ' ')), v{"x", "y"});
+		}
+		SUBCASE("constexpr") {
+			DA_CONSTEXPR auto n = std::ranges::distance(da::split("a,b,c"sv, ','));
+			CHECK_EQ(n, 3);
+		}
+	}
+
+	SUBCASE("stack_string") {
+		da::stack_buffer<256> buf;
+		da::stack_string<256> s(buf);
+		for(int i = 0; i < 10; ++i) { // Longer than SSO
+			s.append("part-");
+		}
+		CHECK_EQ(s.size(), 50);
+		CHECK(buf.owns(s.data()));
+		const size_t used = buf.used();
+		{
+			da::stack_string<256> t(s); // Copied into the same buffer
+			CHECK(buf.owns(t.data()));
+		}
+		CHECK_EQ(buf.used(), used); // The last allocation is reclaimed
+		s.append(300, 'x');         // Exhausted, to the heap
+		CHECK_FALSE(buf.owns(s.data()));
+		CHECK_EQ(std::string_view(s).substr(45), "part-" + std::string(300, 'x'));
+
+		da::stack_buffer<256> other;
+		da::stack_string<256> u("a string in another buffer", other);
+		s = std::move(u); // Copied, since the memory of another buffer cannot be taken
+		CHECK_EQ(std::string_view(s), "a string in another buffer"sv);
+		CHECK_FALSE(other.owns(s.data()));
+		CHECK(other.owns(u.data()));
+	}
+
+	SUBCASE("interner") {
+		SUBCASE("basic") {
+			da::string_interner x;
+			CHECK(x.empty());
+			CHECK_EQ(x.find("a"), da::string_interner::invalid_symbol);
+			const auto a = x.intern("alpha");
+			const auto b = x.intern("beta");
+			CHECK_EQ(a, 0);
+			CHECK_EQ(b, 1);
+			CHECK_EQ(x.intern(std::string("alpha")), a);
+			CHECK_EQ(x.find("beta"), b);
+			CHECK_EQ(x[a], "alpha");
+			CHECK_EQ(x.view(b), "beta");
+			CHECK_EQ(x.intern(""), 2);
+			CHECK_EQ(x.size(), 3);
+			CHECK_EQ(x.bytes(), 9);
+			x.clear();
+			CHECK(x.empty());
+			CHECK_EQ(x.find("alpha"), da::string_interner::invalid_symbol);
+			CHECK_EQ(x.intern(""), 0); // Nothing stored yet
+			CHECK(x.view(0).empty());
+		}
+		SUBCASE("many") {
+			da::string_interner           x;
+			std::vector<std::string>      keys;
+			std::vector<std::string_view> views;
+			for(int i = 0; i < 10000; ++i) {
+				keys.push_back("key" + std::to_string(i));
+				CHECK_EQ(x.intern(keys.back()), static_cast<uint32_t>(i));
+				views.push_back(x.view(i));
+			}
+			for(int i = 0; i < 10000; ++i) {
+				CHECK_EQ(x.find(keys[i]), static_cast<uint32_t>(i));
+				CHECK_EQ(static_cast<const void*>(x.view(i).data()), static_cast<const void*>(views[i].data())); // Views are stable
+			}
+		}
+		SUBCASE("concurrent") {
+			da::concurrent_string_interner     x;
+			constexpr int                      threads = 4, n = 5000;
+			std::vector<std::thread>           workers;
+			std::vector<std::vector<uint32_t>> ids(threads, std::vector<uint32_t>(n));
+			for(int t = 0; t < threads; ++t) {
+				workers.emplace_back([&, t] {
+					for(int i = 0; i < n; ++i) {
+						ids[t][i] = x.intern("label" + std::to_string((i * (t + 1)) % n));
+					}
+				});
+			}
+			for(auto& w : workers) {
+				w.join();
+			}
+			CHECK_EQ(x.size(), n);
+			for(int t = 0; t < threads; ++t) {
+				for(int i = 0; i < n; i += 97) {
+					const auto s = "label" + std::to_string((i * (t + 1)) % n);
+					CHECK_EQ(x.view(ids[t][i]), s);
+					CHECK_EQ(x.find(s), ids[t][i]);
+				}
+			}
+		}
+	}
+
+#if DA_UNIX
+	SUBCASE("mapped_string") {
+		const auto path = std::filesystem::temp_directory_path() / "da-unit-mapped_string.txt";
+		{
+			std::ofstream f(path, std::ios::binary);
+			f << "line1\nline2\n";
+		}
+		{
+			auto s = da::mapped_string::open(path);
+			CHECK(s.is_open());
+			CHECK_EQ(s.size(), 12);
+			CHECK_EQ(std::string_view(s), "line1\nline2\n");
+			CHECK_EQ(s.front(), 'l');
+			CHECK_EQ(s.at(11), '\n');
+			CHECK_THROWS_AS((void)s.at(12), std::out_of_range);
+			CHECK_EQ(collect(da::split_lines(s)), std::vector<std::string_view>{"line1", "line2"});
+			s.advise(da::mapped_string::access_hint::random | da::mapped_string::access_hint::willneed);
+
+			da::mapped_string t = std::move(s);
+			CHECK(!s.is_open());
+			CHECK_EQ(std::string(t.begin(), t.end()), "line1\nline2\n");
+			t.close();
+			CHECK(t.empty());
+		}
+		{
+			std::ofstream f(path, std::ios::binary | std::ios::trunc);
+		}
+		{
+			const da::mapped_string e = da::mapped_string::open(path);
+			CHECK(e.is_open());
+			CHECK(e.empty());
+		}
+		std::filesystem::remove(path);
+		CHECK_THROWS_AS((void)da::mapped_string::open(path), std::system_error);
+	}
+#endif
+}
@@ -10,6 +10,8 @@
 
 #include <da/utility.hpp>
 #include <doctest/doctest.h>
+#include <algorithm>
+#include <vector>
 
 using namespace std::literals;
 
@@ -20,6 +22,23 @@ using namespace std::literals;
 	} while(0)
 
 template class da::fixed_point<5>; // Explicit instantiation so that the coverage is real
+template class da::binary_fixed_point<16>;
+
+// Compare const_divider with plain division
+template<uint64_t D>
+void check_const_divider() {
+	typedef da::detail::const_divider<D> div;
+
+	uint64_t x = 0x9E3779B97F4A7C15;
+	for(int i = 0; i < 2000; ++i) {
+		x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+		for(uint64_t n : {x, x >> (i % 64), x / D * D, x / D * D - 1, uint64_t(i), ~uint64_t(0) - uint64_t(i)}) {
+			CHECK_EQ(div::divide(n), n / D);
+			CHECK_EQ(div::remainder(n), n % D);
+			CHECK_EQ(div::is_divisor_of(n), n % D == 0);
+		}
+	}
+}
 
 TEST_CASE("utility") {
 	SUBCASE("hash") {
@@ -62,6 +81,162 @@ TEST_CASE("utility") {
 			CHECK_CE(da::pow(3.0, 10), 59049.0);
 			CHECK_CE(da::pow(3.0, -1), 1.0 / 3);
 		}
+		SUBCASE("power table") {
+			CHECK_CE(da::pow10(0), 1);
+			CHECK_CE(da::pow10(19), 10000000000000000000ull);
+			CHECK_CE(da::pow10<int32_t>(9), 1000000000);
+			CHECK_CE(da::pow2<int64_t>(62), int64_t(1) << 62);
+			CHECK_EQ(da::detail::power_table_size<uint8_t, 10>, 3);
+			CHECK_EQ(da::detail::power_table_size<int64_t, 10>, 19);
+			CHECK_EQ(da::detail::power_table_size<uint32_t, 2>, 32);
+			CHECK_CE(da::pow(10, 9), 1000000000);
+			CHECK_CE(da::pow(10ull, 19), 10000000000000000000ull);
+			CHECK_CE(da::pow(2ll, 62), int64_t(1) << 62);
+		}
+		SUBCASE("ilog") {
+			CHECK_CE(da::ilog2(1), 0);
+			CHECK_CE(da::ilog2(1023), 9);
+			CHECK_CE(da::ilog2(1024), 10);
+			CHECK_CE(da::ilog2(~0ull), 63);
+			CHECK_CE(da::ilog10(1), 0);
+			CHECK_CE(da::ilog10(9), 0);
+			CHECK_CE(da::ilog10(10), 1);
+			CHECK_CE(da::ilog10(uint8_t(255)), 2);
+			CHECK_CE(da::ilog10(std::numeric_limits<int32_t>::max()), 9);
+			CHECK_CE(da::ilog10(~0ull), 19);
+			for(size_t i = 1; i < 20; ++i) {
+				CHECK_EQ(da::ilog10(da::pow10(i)), i);
+				CHECK_EQ(da::ilog10(da::pow10(i) - 1), i - 1);
+			}
+		}
+		SUBCASE("next_pow2") {
+			CHECK_CE(da::next_pow2(0u), 1u);
+			CHECK_CE(da::next_pow2(1u), 1u);
+			CHECK_CE(da::next_pow2(3u), 4u);
+			CHECK_CE(da::next_pow2(1024u), 1024u);
+			CHECK_CE(da::next_pow2(0x8000000000000000ull), 0x8000000000000000ull);
+		}
+		SUBCASE("checked & saturating") {
+			int32_t r = 0;
+			CHECK(da::checked_add(1, 2, r));
+			CHECK_EQ(r, 3);
+			CHECK_FALSE(da::checked_add(std::numeric_limits<int32_t>::max(), 1, r));
+			CHECK_EQ(r, std::numeric_limits<int32_t>::min());
+			CHECK_FALSE(da::checked_sub(std::numeric_limits<int32_t>::min(), 1, r));
+			CHECK(da::checked_mul(-46341, 46340, r));
+			CHECK_FALSE(da::checked_mul(46341, 46341, r));
+			uint64_t u = 0;
+			CHECK_FALSE(da::checked_sub<uint64_t>(1, 2, u));
+			CHECK_FALSE(da::checked_mul<uint64_t>(0x100000000, 0x100000000, u));
+			CHECK(da::checked_mul<uint64_t>(0xFFFFFFFF, 0x100000001, u));
+			CHECK_EQ(u, ~uint64_t(0));
+
+			CHECK_CE(da::saturating_add(std::numeric_limits<int32_t>::max(), 1), std::numeric_limits<int32_t>::max());
+			CHECK_CE(da::saturating_add(std::numeric_limits<int32_t>::min(), -1), std::numeric_limits<int32_t>::min());
+			CHECK_CE(da::saturating_sub(0, std::numeric_limits<int32_t>::min()), std::numeric_limits<int32_t>::max());
+			CHECK_CE(da::saturating_sub(-2, std::numeric_limits<int32_t>::max()), std::numeric_limits<int32_t>::min());
+			CHECK_CE(da::saturating_sub(1u, 2u), 0u);
+			CHECK_CE(da::saturating_mul(-65536, 65536), std::numeric_limits<int32_t>::min());
+			CHECK_CE(da::saturating_mul(-65536, -65536), std::numeric_limits<int32_t>::max());
+			CHECK_CE(da::saturating_mul(uint8_t(16), uint8_t(16)), uint8_t(255));
+			CHECK_CE(da::saturating_add(40, 2), 42);
+		}
+		SUBCASE("isqrt") {
+			CHECK_CE(da::isqrt(0), 0);
+			CHECK_CE(da::isqrt(1), 1);
+			CHECK_CE(da::isqrt(99), 9);
+			CHECK_CE(da::isqrt(100), 10);
+			CHECK_CE(da::isqrt(~0ull), 0xFFFFFFFFull);
+			CHECK_CE(da::isqrt(0xFFFFFFFE00000001ull), 0xFFFFFFFFull);
+			CHECK_CE(da::isqrt(0xFFFFFFFE00000000ull), 0xFFFFFFFEull);
+			CHECK_CE(da::detail::isqrt(da::detail::u128{0, 1}), 0x100000000ull);
+			CHECK_CE(da::detail::isqrt(da::detail::u128{~0ull, ~0ull - 1}), ~0ull);
+			CHECK_CE(da::sqrt(99), 9);
+			CHECK_CE(da::sqrt(0xFFFFFFFE00000001ull), 0xFFFFFFFFull);
+			CHECK_CE(da::detail::isqrt(da::detail::u128{0, ~0ull - 1}), ~0ull - 1);
+			uint64_t x = 0x9E3779B97F4A7C15;
+			for(int i = 0; i < 1000; ++i) {
+				x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+				const uint64_t         s = da::detail::isqrt(da::detail::u128{x, x >> (i % 64) >> 1});
+				const da::detail::u128 n{x, x >> (i % 64) >> 1};
+				const da::detail::u128 p = da::detail::umul128(s, s);
+				const da::detail::u128 q = da::detail::u128_add(p, {2 * s + 1, s >> 63});
+				CHECK_FALSE(da::detail::u128_less(n, p));
+				CHECK(da::detail::u128_less(n, q));
+			}
+		}
+	}
+	SUBCASE("128-bit") {
+		CHECK_CE(da::detail::umul128(~0ull, ~0ull).hi, ~0ull - 1);
+		CHECK_CE(da::detail::umul128(~0ull, ~0ull).lo, 1);
+		// Compare the preinverted divider with plain division
+		uint64_t x = 0x9E3779B97F4A7C15;
+		for(uint64_t d : {1ull, 3ull, 10ull, 1000000ull, 1000000007ull, 0x8000000000000000ull, ~0ull}) {
+			const da::detail::u128_divider div(d);
+			for(int i = 0; i < 1000; ++i) {
+				x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+				const da::detail::u128 n{x * 0x2545F4914F6CDD1D, x % d};
+				uint64_t               r1, r2;
+				const uint64_t         q1 = div.divide(n, r1);
+				const uint64_t         q2 = da::detail::udiv128(n, d, r2);
+				CHECK_EQ(q1, q2);
+				CHECK_EQ(r1, r2);
+				const da::detail::u128 p = da::detail::umul128(q1, d);
+				CHECK_EQ(p.lo + r1, n.lo);
+			}
+		}
+	}
+	SUBCASE("const_divider") {
+		check_const_divider<1>();
+		check_const_divider<3>();
+		check_const_divider<7>();
+		check_const_divider<10>();
+		check_const_divider<1000>();
+		check_const_divider<100000>();
+		check_const_divider<1000000>();
+		check_const_divider<1024>();
+		check_const_divider<10000000000000000000ull>();
+		check_const_divider<0x8000000000000001ull>();
+		check_const_divider<~0ull>();
+	}
+	SUBCASE("charconv") {
+		CHECK_CE([] {
+			char buf[8]{};
+			return da::to_chars(buf, buf + 8, -1234567).ptr - buf;
+		}(),
+				 8);
+		CHECK_CE([] {
+			const char* s = "123456789012";
+			uint64_t    v = 0;
+			(void)da::from_chars(s, s + 12, v);
+			return v;
+		}(),
+				 123456789012u);
+		char buf[32];
+		auto r = da::to_chars(buf, buf + 3, 1234);
+		CHECK(r.ec == std::errc::value_too_large);
+
+		// Compare with the standard library
+		uint64_t x = 0x9E3779B97F4A7C15;
+		for(int i = 0; i < 1000; ++i) {
+			x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+			for(int64_t n : {static_cast<int64_t>(x), static_cast<int64_t>(x) >> (i % 64), -static_cast<int64_t>(x >> (i % 64))}) {
+				char       expected[32];
+				const auto e = std::to_chars(expected, expected + sizeof(expected), n);
+				r            = da::to_chars(buf, buf + sizeof(buf), n);
+				CHECK_EQ(std::string_view(buf, r.ptr), std::string_view(expected, e.ptr));
+
+				int64_t  v64 = 0, s64 = 0;
+				int32_t  v32 = 0, s32 = 0;
+				uint16_t v16 = 0, s16 = 0;
+				CHECK(da::from_chars(buf, r.ptr, v64).ec == std::from_chars(buf, r.ptr, s64).ec);
+				CHECK(da::from_chars(buf, r.ptr, v32).ec == std::from_chars(buf, r.ptr, s32).ec);
+				CHECK(da::from_chars(buf, r.ptr, v16).ec == std::from_chars(buf, r.ptr, s16).ec);
+				CHECK_EQ(v64, s64);
+				CHECK_EQ(v32, s32);
+				CHECK_EQ(v16, s16);
+			}
+		}
 	}
 	SUBCASE("fixed_point") {
 		using f5 = da::fixed_point<5>;
@@ -82,6 +257,23 @@ TEST_CASE("utility") {
 		SUBCASE("is_integer") {
 			CHECK_CE(f5{1}.is_integer(), true);
 			CHECK_CE(f5{1.5}.is_integer(), false);
+			CHECK_CE(f5{-3}.is_integer(), true);
+			CHECK_CE(f5::from_raw(-299999).is_integer(), false);
+			CHECK_CE(f5::from_raw(std::numeric_limits<int64_t>::min()).is_integer(), false);
+			CHECK_CE((da::fixed_point<3, int32_t>{-7}.is_integer()), true);
+		}
+		SUBCASE("rescale") {
+			// Compare with the plain division
+			for(int64_t raw : {int64_t(0), int64_t(1), int64_t(-1), int64_t(123456789), int64_t(-987654321987), std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()}) {
+				CHECK_EQ(f5{f6::from_raw(raw)}.raw(), raw / 10);
+				CHECK_EQ((da::fixed_point<2>{f6::from_raw(raw)}.raw()), raw / 10000);
+				CHECK_EQ(f6::from_raw(raw).get<int64_t>(), raw / 1000000);
+				CHECK_EQ(f6::from_raw(raw).is_integer(), raw % 1000000 == 0);
+			}
+			CHECK_CE(f6{f5::from_raw(-12345)}.raw(), -123450);
+			CHECK_CE(f5{f6::from_raw(-123456)}.raw(), -12345);
+			CHECK_CE(f6{3000}.get<int64_t>(), 3000);
+			CHECK_CE(f6{-2.5}.get<int>(), -2);
 		}
 		SUBCASE("add") {
 			CHECK_CE(f5{1} + 2, 3);
@@ -107,6 +299,17 @@ TEST_CASE("utility") {
 			CHECK_CE(f5{1} /= 2, 0.5);
 			CHECK_CE(f5{1} /= f5{2}, 0.5);
 		}
+		SUBCASE("wide intermediate") {
+			// The products exceed int64_t
+			CHECK_CE(f6{3000} * f6{4000}, 12000000);
+			CHECK_CE(f6{-3000} * f6{4000}, -12000000);
+			CHECK_CE(f6{12000000} / f6{4000}, 3000);
+			CHECK_CE(f6{12000000} / f6{-4000}, -3000);
+			CHECK_CE((f6::from_raw(123456789012) * f6::from_raw(98765432109)).raw(), 12193263113559823);
+			CHECK_CE((f6::from_raw(-987654321098765) * f6::from_raw(123456789)).raw(), -121932631124828478);
+			CHECK_CE((f6{1000000000000} / f6{3}).raw(), 333333333333333333);
+			CHECK_CE((da::fixed_point<4, int32_t>{40000} * da::fixed_point<4, int32_t>{5}), 200000);
+		}
 		SUBCASE("mix") {
 			CHECK_CE(((-f5{1} + f5{2} - f5{0.5}) * f5{3} / f5{5}), 0.3);
 		}
@@ -135,6 +338,267 @@ TEST_CASE("utility") {
 		SUBCASE("format") {
 			CHECK_EQ(da::fmt::format("{}", f5{1}), "1");
 			CHECK_EQ(da::fmt::format("{:*^+10.2f}", f5{1.502}), "**+1.50***");
+			CHECK_EQ(da::fmt::format("{}", f6::from_raw(-1500)), "-0.0015");
+			CHECK_EQ(da::fmt::format("{:.3}", f6::from_raw(-1500)), "-0.002");
+			CHECK_EQ(da::fmt::format("{:.1f}", f6::from_raw(9950000)), "10.0");
+			CHECK_EQ(da::fmt::format("{:.8}", f6{2}), "2.00000000");
+			CHECK_EQ(da::fmt::format("{:08.2f}", f6{-3.25}), "-0003.25");
+			CHECK_EQ(da::fmt::format("{:<6}|{:>6}|{: }", f6{1.5}, f6{1.5}, f6{1.5}), "1.5   |   1.5| 1.5");
+			CHECK_EQ(da::fmt::format("{}", f6::from_raw(std::numeric_limits<int64_t>::min())), "-9223372036854.775808");
+			CHECK_EQ(da::fmt::format("{}", da::fixed_point<0>{42}), "42");
+			CHECK_EQ(da::fmt::format("{}", da::fixed_point<2, uint8_t>::from_raw(255)), "2.55");
+			CHECK_THROWS_AS((void)da::fmt::format(da::fmt::runtime("{:x}"), f5{1}), da::fmt::format_error);
+		}
+		SUBCASE("to_chars") {
+			char buf[32];
+			auto r = da::to_chars(buf, buf + sizeof(buf), f6::from_raw(123456789));
+			CHECK_EQ(std::string_view(buf, r.ptr), "123.456789"sv);
+			r = da::to_chars(buf, buf + sizeof(buf), f6::from_raw(123456789), 0);
+			CHECK_EQ(std::string_view(buf, r.ptr), "123"sv);
+			r = da::to_chars(buf, buf + 3, f6::from_raw(123456789));
+			CHECK(r.ec == std::errc::value_too_large);
+		}
+		SUBCASE("from_chars") {
+			auto parse = [](std::string_view s, f6& v) { return da::from_chars(s.data(), s.data() + s.size(), v); };
+
+			f6   v;
+			auto r = parse("123.456789", v);
+			CHECK(r.ec == std::errc());
+			CHECK_EQ(v.raw(), 123456789);
+			const auto input = "-0.5x"sv;
+			CHECK_EQ(da::from_chars(input.data(), input.data() + input.size(), v).ptr, input.data() + 4);
+			CHECK_EQ(v.raw(), -500000);
+			parse("7", v);
+			CHECK_EQ(v.raw(), 7000000);
+			parse(".25", v);
+			CHECK_EQ(v.raw(), 250000);
+			parse("1.", v);
+			CHECK_EQ(v.raw(), 1000000);
+			parse("0.00000050", v); // Round half away from zero
+			CHECK_EQ(v.raw(), 1);
+			parse("-0.0000014999", v);
+			CHECK_EQ(v.raw(), -1);
+			parse("-9223372036854.775808", v);
+			CHECK_EQ(v.raw(), std::numeric_limits<int64_t>::min());
+
+			v = f6{1};
+			CHECK(parse("9223372036854.775808", v).ec == std::errc::result_out_of_range);
+			CHECK(parse("99999999999999999999", v).ec == std::errc::result_out_of_range);
+			CHECK(parse("", v).ec == std::errc::invalid_argument);
+			CHECK(parse(".", v).ec == std::errc::invalid_argument);
+			CHECK(parse("-", v).ec == std::errc::invalid_argument);
+			CHECK(parse("+1", v).ec == std::errc::invalid_argument);
+			CHECK_EQ(v.raw(), 1000000);
+
+			// Round trip
+			uint64_t x = 0x9E3779B97F4A7C15;
+			for(int i = 0; i < 1000; ++i) {
+				x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+				const f6 a = f6::from_raw(static_cast<int64_t>(x) >> (i % 64));
+				char     buf[32];
+				auto     w = da::to_chars(buf, buf + sizeof(buf), a);
+				f6       b;
+				auto     q = da::from_chars(buf, w.ptr, b);
+				CHECK(q.ptr == w.ptr);
+				CHECK_EQ(a, b);
+			}
+		}
+		SUBCASE("sqrt & transcendental") {
+			CHECK_CE(da::sqrt(f5(2)), f5::from_raw(141421));
+			CHECK_CE(da::sqrt(f5(0)), 0);
+			CHECK_CE(da::exp(f5(0)), 1);
+			CHECK_CE(da::exp(f5(1)), f5::from_raw(271828));
+			CHECK_CE(da::exp(f5(-100)), 0);
+			CHECK_CE(da::exp(f5(100)).raw(), std::numeric_limits<int64_t>::max());
+			CHECK_CE(da::log(f5(1)), 0);
+			CHECK_CE(da::log(f5(10)), f5::from_raw(230259));
+			CHECK_CE(da::sin(f5(0)), 0);
+			CHECK_CE(da::cos(f5(0)), 1);
+			CHECK_CE(da::sin(f5(-1)), f5::from_raw(-84147));
+			CHECK_CE(da::atan2(f5(0), f5(0)), 0);
+			CHECK_CE(da::atan2(f5(0), f5(-1)), f5::from_raw(314159));
+			CHECK_CE(da::atan2(f5(-1), f5(0)), f5::from_raw(-157080));
+
+			// At most 1 ULP from the long double result
+			auto check = [](auto r, long double ref) {
+				CHECK_LE(std::abs(static_cast<long double>(r.raw()) - ref * 1e6L), 1);
+			};
+			uint64_t x = 0x9E3779B97F4A7C15;
+			for(int i = 0; i < 1000; ++i) {
+				x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+				const f6          a  = f6::from_raw(static_cast<int64_t>(x % 200000000) - 100000000);
+				const f6          b  = f6::from_raw(static_cast<int64_t>(x >> 40) - (1 << 23));
+				const long double av = a.raw() / 1e6L, bv = b.raw() / 1e6L;
+				check(da::sin(a), std::sin(av));
+				check(da::cos(a), std::cos(av));
+				check(da::atan2(a, b), std::atan2(av, bv));
+				check(da::exp(b), std::exp(bv));
+				if(a > 0) {
+					check(da::sqrt(a), std::sqrt(av));
+					check(da::log(a), std::log(av));
+				}
+			}
+			CHECK_EQ(da::sqrt(da::fixed_point<2, double>(2)), da::fixed_point<2, double>(std::sqrt(2.0)));
 		}
 	}
+	SUBCASE("binary_fixed_point") {
+		using q  = da::q16_16;
+		using qs = da::binary_fixed_point<16, int32_t, da::overflow_policy::saturate>;
+		using q8 = da::binary_fixed_point<7, uint8_t, da::overflow_policy::saturate>;
+		SUBCASE("constructor") {
+			CHECK_CE(q{}, 0);
+			CHECK_CE(q{1}.raw(), 65536);
+			CHECK_CE(q{-1.5}.raw(), -98304);
+			CHECK_CE((q{1, da::no_conversion}.raw()), 1);
+			CHECK_CE(q{da::binary_fixed_point<4>{1.25}}.raw(), 81920);
+			CHECK_CE(da::binary_fixed_point<4>{q::from_raw(-98305)}.raw(), -24);
+			CHECK_CE(da::q32_32{q{-7.5}}, -7.5);
+		}
+		SUBCASE("getter & setter") {
+			CHECK_CE(int(q{-2.75}), -2);
+			CHECK_CE(double(q{-2.75}), -2.75);
+			q x;
+			CHECK_EQ(x.set(3).get<int>(), 3);
+			CHECK_CE(q{-2.75}.is_integer(), false);
+			CHECK_CE(q{-3}.is_integer(), true);
+		}
+		SUBCASE("arithmetic") {
+			CHECK_CE(q{1.5} + q{-2.25}, -0.75);
+			CHECK_CE(q{1.5} - 2, -0.5);
+			CHECK_CE(2 - q{1.5}, 0.5);
+			CHECK_CE(q{1.5} * q{-2.25}, -3.375);
+			CHECK_CE(q{1.5} * 3, 4.5);
+			CHECK_CE(q{-3} / q{4}, -0.75);
+			CHECK_CE(q{-3} / 4, -0.75);
+			CHECK_CE(1 / q{4}, 0.25);
+			CHECK_CE(q::from_raw(-1) * q{0.5}, 0); // Rounded toward zero
+			CHECK_CE((q{1} /= 3).raw(), 21845);
+			CHECK_CE((-q{1} + q{2} - q{0.5}) * q{3} / q{5}, q{0.5} * 3 / 5);
+
+			// The products exceed int64_t
+			CHECK_CE(da::q32_32{3000000} * da::q32_32{-500}, -1500000000);
+			CHECK_CE(da::q32_32{1500000000} / da::q32_32{-500}, -3000000);
+			CHECK_CE((da::q32_32::from_raw(0x123456789ABCDEF) * da::q32_32::from_raw(0x7654321)).raw(), 0x86A1C97530ECA);
+		}
+		SUBCASE("saturate") {
+			constexpr int32_t max = std::numeric_limits<int32_t>::max();
+			constexpr int32_t min = std::numeric_limits<int32_t>::min();
+			CHECK_CE(qs{40000}.raw(), max);
+			CHECK_CE(qs{-1e10}.raw(), min);
+			CHECK_CE((qs{30000} + qs{30000}).raw(), max);
+			CHECK_CE((qs{-30000} - qs{30000}).raw(), min);
+			CHECK_CE((qs{300} * qs{-300}).raw(), min);
+			CHECK_CE((qs{300} * 300).raw(), max);
+			CHECK_CE((qs{300} / qs{0.001}).raw(), max);
+			CHECK_CE((-qs::from_raw(min)).raw(), max);
+			CHECK_CE((qs::from_raw(min) / -1).raw(), max);
+			CHECK_CE((q8{0.5} - q8{0.75}).raw(), 0);
+			CHECK_CE((q8{1.5} + q8{0.75}).raw(), 255);
+			CHECK_CE((q8{0.5} * q8{0.5}).raw(), 32);
+			CHECK_CE((q{30000} + q{30000}).raw(), static_cast<int32_t>(60000u * 65536u)); // Wrapped
+			CHECK_EQ(q{40000.0}.raw(), static_cast<int32_t>(40000u * 65536u));
+			CHECK_EQ(q{-40000.5}.raw(), static_cast<int32_t>(0u - 2621472768u));
+			CHECK_EQ(da::q32_32{-3e9}.raw(), static_cast<int64_t>(0 - uint64_t(3000000000) * (uint64_t(1) << 32)));
+			CHECK_EQ(q{std::numeric_limits<double>::quiet_NaN()}.raw(), 0);
+			CHECK_EQ(q{std::numeric_limits<double>::infinity()}.raw(), 0);
+			CHECK_EQ(qs{std::numeric_limits<double>::quiet_NaN()}.raw(), 0);
+			CHECK_EQ(qs{-std::numeric_limits<double>::infinity()}.raw(), min);
+			CHECK_CE((da::binary_fixed_point<32, int64_t, da::overflow_policy::saturate>{-3e9} * 4).raw(), std::numeric_limits<int64_t>::min());
+		}
+		SUBCASE("decimal") {
+			using f6 = da::fixed_point<6>;
+			CHECK_CE(q{f6{-1.5}}.raw(), -98304);
+			CHECK_CE(q{f6::from_raw(1)}.raw(), 0);
+			CHECK_CE(q{f6::from_raw(16)}.raw(), 1); // 2^-16 ~= 0.0000152587
+			CHECK_CE(f6{q{-1.5}}.raw(), -1500000);
+			CHECK_CE(f6{q::from_raw(1)}.raw(), 15);
+			CHECK_CE(qs{f6{1e8}}.raw(), std::numeric_limits<int32_t>::max());
+			CHECK_CE(da::fixed_point<2>{da::q32_32{-0.015625}}.raw(), -1);
+			// Compare with the plain arithmetic
+			for(int64_t raw = -100000; raw <= 100000; raw += 37) {
+				CHECK_EQ(f6{q::from_raw(static_cast<int32_t>(raw))}.raw(), raw * 1000000 / 65536);
+				CHECK_EQ(q{f6::from_raw(raw)}.raw(), raw * 65536 / 1000000);
+			}
+		}
+		SUBCASE("comparison") {
+			CHECK_CE(q{1} < q{2}, true);
+			CHECK_CE(q{1} != q{2}, true);
+			CHECK_CE(q{-0.5} < 0, true);
+			CHECK_CE(q{-0.5} > -1, true);
+			CHECK_CE(q{2} == 2, true);
+			CHECK_CE(q{2.5} > 2, true);
+			CHECK_CE(q{2.5} < 3u, true);
+			CHECK_CE(q{2.5} == 2.5, true);
+			CHECK_CE(1 < q{1.5}, true);
+			CHECK_CE(q{30000} < 4000000000ll, true);
+		}
+		SUBCASE("format") {
+			CHECK_EQ(da::fmt::format("{:.3f}", q{-1.5}), "-1.500");
+			CHECK_EQ(da::fmt::format("{}", q::from_raw(1)), "1.52587890625e-05");
+		}
+	}
+	SUBCASE("batch") {
+		using f6 = da::fixed_point<6>;
+
+		// Sizes not divisible by the SIMD width to cover the tails
+		std::vector<f6> a, b, c;
+		uint64_t        x = 0x9E3779B97F4A7C15;
+		for(int i = 0; i < 1003; ++i) {
+			x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+			a.push_back(f6::from_raw(static_cast<int64_t>(x) >> 20));
+			b.push_back(f6::from_raw(static_cast<int64_t>(x * 31) >> 34));
+			c.push_back(f6::from_raw(static_cast<int64_t>(x * 17) >> 24));
+		}
+		std::vector<f6> out(a.size());
+
+		da::add(std::span(std::as_const(a)), std::span(b), std::span(out));
+		for(size_t i = 0; i < a.size(); ++i) {
+			CHECK_EQ(out[i], a[i] + b[i]);
+		}
+		da::multiply(std::span(a), std::span(b), std::span(out));
+		for(size_t i = 0; i < a.size(); ++i) {
+			CHECK_EQ(out[i], a[i] * b[i]);
+		}
+		da::fma(std::span(a), std::span(b), std::span(c), std::span(out));
+		for(size_t i = 0; i < a.size(); ++i) {
+			CHECK_EQ(out[i], a[i] * b[i] + c[i]);
+		}
+
+		f6 s, d;
+		for(size_t i = 0; i < a.size(); ++i) {
+			s += a[i];
+			d += a[i] * b[i];
+		}
+		CHECK_EQ(da::sum(std::span(a)), s);
+		CHECK_EQ(da::dot(std::span(a), std::span(std::as_const(b))), d);
+		CHECK_EQ(da::min(std::span(a)), *std::min_element(a.begin(), a.end()));
+		CHECK_EQ(da::max(std::span(a)), *std::max_element(a.begin(), a.end()));
+		CHECK_EQ(da::min(std::span(a).first(3)), *std::min_element(a.begin(), a.begin() + 3));
+		CHECK_EQ(da::max(std::span(a).subspan(7)), *std::max_element(a.begin() + 7, a.end()));
+
+		// The partial sums overflow but the result doesn't
+		const int64_t   big = std::numeric_limits<int64_t>::max();
+		std::vector<f6> w   = {f6::from_raw(big), f6::from_raw(big), f6::from_raw(-big), f6::from_raw(-1), f6::from_raw(big), f6::from_raw(-big)};
+		CHECK_EQ(da::sum(std::span(w)).raw(), big - 1);
+		w.push_back(f6::from_raw(2));
+		CHECK_THROWS_AS((void)da::sum(std::span(w)), std::overflow_error);
+		std::vector<f6> m(9, f6::from_raw(std::numeric_limits<int64_t>::min()));
+		CHECK_THROWS_AS((void)da::sum(std::span(m)), std::overflow_error);
+		CHECK_EQ(da::sum(std::span(m).first(1)).raw(), std::numeric_limits<int64_t>::min());
+
+		std::vector<da::fixed_point<2>> lower(a.size());
+		std::vector<da::fixed_point<9>> higher(a.size());
+		da::rescale(std::span(a), std::span(lower));
+		da::rescale(std::span(a), std::span(higher));
+		for(size_t i = 0; i < a.size(); ++i) {
+			CHECK_EQ(lower[i], da::fixed_point<2>(a[i]));
+			CHECK_EQ(higher[i], da::fixed_point<9>(a[i]));
+		}
+
+		std::vector<da::fixed_point<2, int32_t>> small = {1.5, -2.25, 3};
+		CHECK_EQ(da::sum(std::span(small)), 2.25);
+		CHECK_EQ(da::max(std::span(small)), 3);
+		std::vector<da::fixed_point<2, int32_t>> overflow(2, da::fixed_point<2, int32_t>::from_raw(std::numeric_limits<int32_t>::max()));
+		CHECK_THROWS_AS((void)da::sum(std::span(overflow)), std::overflow_error);
+	}
 }